@@ -0,0 +1,100 @@
+//////////////////////////////////
+//     PIXEL WIRE FORMATS       //
+//////////////////////////////////
+#pragma once
+#include <Arduino.h>
+#include <type_traits>
+
+/**
+ * @file 045_PIXEL_FORMAT.h
+ * @brief Compile-time color order and white handling of a strip's wire bytes.
+ *
+ * A HAL profile picks one PIXEL::Format<Order, White>. Its Encode() writes
+ * one RGBW pixel as the strip expects it on the wire. The byte positions
+ * and the white handling are template constants, so the output loop has no
+ * per-pixel branching or packing. A new strip type only needs a new Order
+ * (or White policy) here; neither the HAL loops nor the LED core change.
+ *
+ * No hardware access: 210_LED_CORE.h uses the same formats for
+ * LED_CORE_WIRE_OUTPUT, also in host builds.
+ */
+
+namespace PIXEL {
+
+inline constexpr uint8_t kNoByte = 0xFF;  ///< Order position of a channel the strip does not have
+
+/**
+ * @brief Byte position of each channel within one pixel on the wire.
+ */
+template<uint8_t R, uint8_t G, uint8_t B, uint8_t W = kNoByte>
+struct Order {
+  static constexpr uint8_t kR = R;
+  static constexpr uint8_t kG = G;
+  static constexpr uint8_t kB = B;
+  static constexpr uint8_t kW = W;
+  static constexpr bool kHasWhite = (W != kNoByte);
+  static constexpr uint8_t kStride = kHasWhite ? 4 : 3;
+};
+
+namespace ORDER {
+using RGB = Order<0, 1, 2>;
+using GRB = Order<1, 0, 2>;
+using BRG = Order<1, 2, 0>;
+using RGBW = Order<0, 1, 2, 3>;
+using GRBW = Order<1, 0, 2, 3>;
+using WRGB = Order<1, 2, 3, 0>;
+}  // namespace ORDER
+
+/**
+ * @brief What happens to the W channel of a pixel.
+ */
+namespace WHITE {
+struct Native {};      ///< sent in its own byte (the Order needs a W position)
+struct MixIntoRgb {};  ///< added to R, G and B, saturating at 255 (RGB-only strips)
+struct Drop {};        ///< not sent; a W byte in the Order is sent as 0
+}  // namespace WHITE
+
+inline uint8_t AddSaturated(uint8_t color, uint8_t white) {
+  const uint16_t sum = static_cast<uint16_t>(color) + static_cast<uint16_t>(white);
+  return static_cast<uint8_t>(sum > 255 ? 255 : sum);
+}
+
+template<typename OrderT, typename WhiteT>
+struct Format {
+  using ColorOrder = OrderT;
+  using White = WhiteT;
+
+  static_assert(!std::is_same<WhiteT, WHITE::Native>::value || OrderT::kHasWhite,
+                "WHITE::Native needs an Order with a W byte");
+
+  static constexpr uint8_t kStride = OrderT::kStride;
+
+  /**
+   * @brief Write one pixel (kStride bytes) to `dst`.
+   */
+  static void Encode(uint8_t *dst, uint8_t r, uint8_t g, uint8_t b, uint8_t w) {
+    if constexpr (std::is_same<WhiteT, WHITE::MixIntoRgb>::value) {
+      r = AddSaturated(r, w);
+      g = AddSaturated(g, w);
+      b = AddSaturated(b, w);
+    }
+    dst[OrderT::kR] = r;
+    dst[OrderT::kG] = g;
+    dst[OrderT::kB] = b;
+    if constexpr (OrderT::kHasWhite) {
+      dst[OrderT::kW] = std::is_same<WhiteT, WHITE::Native>::value ? w : 0;
+    }
+  }
+
+  /**
+   * @brief Encode `count` pixels (structs with R, G, B, W members) back to back into `dst`.
+   */
+  template<typename Pixel>
+  static void EncodeFrame(uint8_t *dst, const Pixel *pixels, uint16_t count) {
+    for (uint16_t i = 0; i < count; ++i, dst += kStride) {
+      Encode(dst, pixels[i].R, pixels[i].G, pixels[i].B, pixels[i].W);
+    }
+  }
+};
+
+}  // namespace PIXEL
@@ -8,7 +8,8 @@
 
 #pragma once
 
-
+#include "045_PIXEL_FORMAT.h"
+#include "055_HAL_SHOW.h"
 
 // Select default configuration if nothing else is specified.
 #if !defined(HAL_CONFIG_SINGLE_WS2812) && !defined(HAL_CONFIG_DUAL_WS2812) && \
@@ -28,13 +29,51 @@ inline bool InitLedHardware();
 inline void ClearLedHardware();
 inline void SetPixelColor(uint16_t index, uint8_t r, uint8_t g, uint8_t b,
                           uint8_t w);
+template<typename Pixel>
+inline void WriteFrame(const Pixel* pixels, uint16_t count);
+inline uint8_t* GetFrameBuffer(uint8_t strip);
 inline void ShowLedHardware();
+inline bool IsShowComplete();
+inline const ShowStats& GetShowStats();
 inline uint16_t GetLogicalLedCount();
 inline const char* GetHardwareConfigLabel();
 inline uint8_t MixWhite(uint8_t color, uint8_t white);
 
+/*
+ * Frame output: WriteFrame(pixels, count) takes the whole frame (any struct
+ * with uint8_t R, G, B, W members, e.g. LED::CORE::Pixel_byte) and copies it
+ * into the driver buffer in one loop. SetPixelColor() stays as the per-pixel
+ * fallback for callers without a contiguous frame (LED_CORE_SOA).
+ *
+ * Zero-copy output (LED_CORE_WIRE_OUTPUT): every profile also publishes the
+ * buffer its driver transmits from, GetFrameBuffer(strip), the pixels in the
+ * first one (kFrameSplit) and its wire format, so the LED core can render
+ * straight into it.
+ *
+ * Each profile's wire format is HAL::Format, a PIXEL::Format<Order, White>
+ * (045_PIXEL_FORMAT.h) chosen by its *_ORDER / *_WHITE defines. SetPixelColor()
+ * and WriteFrame() encode through it straight into the driver buffer, so
+ * neither packs colors nor branches on the strip type per pixel.
+ *
+ * Show (055_HAL_SHOW.h): profiles that own their frame keep it in
+ * FrameBuffers and ShowLedHardware() presents it. With HAL_ASYNC_SHOW the
+ * call returns while the frame is still being sent and GetFrameBuffer()
+ * moves to the other buffer; IsShowComplete() tells when the wire is free.
+ * Adafruit_NeoPixel profiles always block and report complete.
+ */
+
+
 
+#if defined(HAL_CONFIG_SINGLE_WS2812) || defined(HAL_CONFIG_DUAL_WS2812)
+
+/**
+ * @brief Bytes per pixel of an Adafruit_NeoPixel NEO_* type (W sharing R's offset means no W byte).
+ */
+inline constexpr uint8_t NeoPixelStride(uint16_t type) {
+  return (((type >> 6) & 0x03) == ((type >> 4) & 0x03)) ? 3 : 4;
+}
 
+#endif
 
 
 #if defined(HAL_CONFIG_SINGLE_WS2812)
@@ -51,10 +90,54 @@ inline uint8_t MixWhite(uint8_t color, uint8_t white);
 #define HAL_SINGLE_WS2812_PIXEL_TYPE (NEO_RGBW + NEO_KHZ800)
 #endif
 
+// Byte order on the wire and white handling (045_PIXEL_FORMAT.h); the driver
+// only takes timing and bytes per pixel from HAL_SINGLE_WS2812_PIXEL_TYPE.
+#ifndef HAL_SINGLE_WS2812_ORDER
+#define HAL_SINGLE_WS2812_ORDER PIXEL::ORDER::GRBW
+#endif
+
+#ifndef HAL_SINGLE_WS2812_WHITE
+#define HAL_SINGLE_WS2812_WHITE PIXEL::WHITE::Native
+#endif
+
 inline constexpr uint8_t kDataPin = HAL_SINGLE_WS2812_PIN;
 inline constexpr uint16_t kLedCount = HAL_SINGLE_WS2812_LED_COUNT;
 
+using Format = PIXEL::Format<HAL_SINGLE_WS2812_ORDER, HAL_SINGLE_WS2812_WHITE>;
+static_assert(Format::kStride == NeoPixelStride(HAL_SINGLE_WS2812_PIXEL_TYPE),
+              "HAL_SINGLE_WS2812_ORDER and HAL_SINGLE_WS2812_PIXEL_TYPE disagree on bytes per pixel");
+
+#if HAL_ASYNC_SHOW
+// Own frame buffers instead of Adafruit_NeoPixel's, sent by a non-blocking transmitter.
+#if HAL_HAS_RMT_TRANSMITTER
+using Transmitter = RmtTransmitter;
+#elif defined(ARDUINO_ARCH_ESP32)
+#error "HAL_ASYNC_SHOW with HAL_CONFIG_SINGLE_WS2812 needs arduino-esp32 2.x (RmtTransmitter uses the legacy driver/rmt.h)"
+#elif !defined(ARDUINO)
+using Transmitter = MockTransmitter;
+#else
+#error "HAL_ASYNC_SHOW with HAL_CONFIG_SINGLE_WS2812 needs the ESP32 RMT"
+#endif
+
+inline FrameBuffers<Transmitter, kLedCount * Format::kStride> g_frames;
+
+inline bool InitLedHardware() {
+  return g_frames.tx.Configure(kDataPin, 800000, 300);  // 800 kHz, >280 us reset
+}
+
+inline void ClearLedHardware() { memset(g_frames.Back(), 0, kLedCount * Format::kStride); }
+
+inline uint8_t* FrameBytes() { return g_frames.Back(); }
+
+inline void ShowLedHardware() { g_frames.Present(); }
+
+inline bool IsShowComplete() { return g_frames.TransmissionComplete(); }
+
+inline const ShowStats& GetShowStats() { return g_frames.stats; }
+
+#else
 inline Adafruit_NeoPixel g_strip(kLedCount, kDataPin, HAL_SINGLE_WS2812_PIXEL_TYPE);
+inline ShowStats g_showStats;
 
 inline bool InitLedHardware() {
   g_strip.begin();
@@ -65,12 +148,32 @@ inline bool InitLedHardware() {
 
 inline void ClearLedHardware() { g_strip.clear(); }
 
+inline uint8_t* FrameBytes() { return g_strip.getPixels(); }
+
+inline void ShowLedHardware() {
+  g_strip.show();
+  ++g_showStats.frames;
+}
+
+inline bool IsShowComplete() { return true; }
+
+inline const ShowStats& GetShowStats() { return g_showStats; }
+#endif
+
 inline void SetPixelColor(uint16_t index, uint8_t r, uint8_t g, uint8_t b, uint8_t w) {
   if (index >= kLedCount) return;
-  g_strip.setPixelColor(index, g_strip.Color(g, r, b, w));
+  Format::Encode(FrameBytes() + index * Format::kStride, r, g, b, w);
 }
 
-inline void ShowLedHardware() { g_strip.show(); }
+template<typename Pixel>
+inline void WriteFrame(const Pixel* pixels, uint16_t count) {
+  if (count > kLedCount) count = kLedCount;
+  Format::EncodeFrame(FrameBytes(), pixels, count);
+}
+
+inline constexpr uint16_t kFrameSplit = kLedCount;
+
+inline uint8_t* GetFrameBuffer(uint8_t strip) { return strip == 0 ? FrameBytes() : nullptr; }
 
 inline const char* GetHardwareConfigLabel() { return "HAL_CONFIG_SINGLE_WS2812"; }
 
@@ -100,14 +203,31 @@ inline const char* GetHardwareConfigLabel() { return "HAL_CONFIG_SINGLE_WS2812";
 #define HAL_DUAL_WS2812_PIXEL_TYPE (NEO_RGBW + NEO_KHZ800)
 #endif
 
+#ifndef HAL_DUAL_WS2812_ORDER
+#define HAL_DUAL_WS2812_ORDER PIXEL::ORDER::GRBW
+#endif
+
+#ifndef HAL_DUAL_WS2812_WHITE
+#define HAL_DUAL_WS2812_WHITE PIXEL::WHITE::Native
+#endif
+
 inline constexpr uint16_t kStripOneCount = HAL_DUAL_WS2812_COUNT_ONE;
 inline constexpr uint16_t kStripTwoCount = HAL_DUAL_WS2812_COUNT_TWO;
 inline constexpr uint16_t kLedCount = kStripOneCount + kStripTwoCount;
 
+#if HAL_ASYNC_SHOW
+#error "HAL_ASYNC_SHOW is not available for HAL_CONFIG_DUAL_WS2812 (Adafruit_NeoPixel::show() blocks)"
+#endif
+
+using Format = PIXEL::Format<HAL_DUAL_WS2812_ORDER, HAL_DUAL_WS2812_WHITE>;
+static_assert(Format::kStride == NeoPixelStride(HAL_DUAL_WS2812_PIXEL_TYPE),
+              "HAL_DUAL_WS2812_ORDER and HAL_DUAL_WS2812_PIXEL_TYPE disagree on bytes per pixel");
+
 inline Adafruit_NeoPixel g_stripOne(kStripOneCount, HAL_DUAL_WS2812_PIN_ONE,
                                     HAL_DUAL_WS2812_PIXEL_TYPE);
 inline Adafruit_NeoPixel g_stripTwo(kStripTwoCount, HAL_DUAL_WS2812_PIN_TWO,
                                     HAL_DUAL_WS2812_PIXEL_TYPE);
+inline ShowStats g_showStats;
 
 inline bool InitLedHardware() {
   g_stripOne.begin();
@@ -126,21 +246,41 @@ inline void ClearLedHardware() {
 inline void SetPixelColor(uint16_t index, uint8_t r, uint8_t g, uint8_t b,
                           uint8_t w) {
   if (index < kStripOneCount) {
-    g_stripOne.setPixelColor(index, g_stripOne.Color(g, r, b, w));
+    Format::Encode(g_stripOne.getPixels() + index * Format::kStride, r, g, b, w);
     return;
   }
 
   const uint16_t localIndex = static_cast<uint16_t>(index - kStripOneCount);
   if (localIndex < kStripTwoCount) {
-    g_stripTwo.setPixelColor(localIndex, g_stripTwo.Color(g, r, b, w));
+    Format::Encode(g_stripTwo.getPixels() + localIndex * Format::kStride, r, g, b, w);
   }
 }
 
+template<typename Pixel>
+inline void WriteFrame(const Pixel* pixels, uint16_t count) {
+  const uint16_t countOne = count < kStripOneCount ? count : kStripOneCount;
+  Format::EncodeFrame(g_stripOne.getPixels(), pixels, countOne);
+
+  uint16_t countTwo = static_cast<uint16_t>(count - countOne);
+  if (countTwo > kStripTwoCount) countTwo = kStripTwoCount;
+  Format::EncodeFrame(g_stripTwo.getPixels(), pixels + countOne, countTwo);
+}
+
+inline constexpr uint16_t kFrameSplit = kStripOneCount;
+
+inline uint8_t* GetFrameBuffer(uint8_t strip) {
+  return strip == 0 ? g_stripOne.getPixels() : g_stripTwo.getPixels();
+}
+
 inline void ShowLedHardware() {
   g_stripOne.show();
   g_stripTwo.show();
+  ++g_showStats.frames;
 }
 
+inline bool IsShowComplete() { return true; }
+
+inline const ShowStats& GetShowStats() { return g_showStats; }
 
 inline const char* GetHardwareConfigLabel() {
   return "HAL_CONFIG_DUAL_WS2812";
@@ -164,24 +304,57 @@ inline const char* GetHardwareConfigLabel() {
 #define HAL_SINGLE_WS2801_LED_COUNT 31
 #endif
 
+// WS2801 strips take 3 bytes per pixel; W is mixed into RGB unless overridden.
+#ifndef HAL_SINGLE_WS2801_ORDER
+#define HAL_SINGLE_WS2801_ORDER PIXEL::ORDER::RGB
+#endif
+
+#ifndef HAL_SINGLE_WS2801_WHITE
+#define HAL_SINGLE_WS2801_WHITE PIXEL::WHITE::MixIntoRgb
+#endif
+
+// SPI clock the strip is driven with. The WS2801 takes up to 25 MHz and every
+// chip re-clocks the data, so only the wiring to the first pixel limits it;
+// lower it if long leads make the strip flicker.
+#ifndef HAL_SINGLE_WS2801_CLOCK_HZ
+#define HAL_SINGLE_WS2801_CLOCK_HZ 8000000
+#endif
+
 inline constexpr uint16_t kLedCount = HAL_SINGLE_WS2801_LED_COUNT;
 
-inline bool InitLedHardware() {
+using Format = PIXEL::Format<HAL_SINGLE_WS2801_ORDER, HAL_SINGLE_WS2801_WHITE>;
+inline constexpr uint16_t kFrameSplit = kLedCount;
 
-  return true;
+inline FrameBuffers<SpiTransmitter, kLedCount * Format::kStride> g_frames;  ///< packed frame(s) in wire order
+
+inline uint8_t* GetFrameBuffer(uint8_t strip) { return strip == 0 ? g_frames.Back() : nullptr; }
+
+inline bool InitLedHardware() {
+  // one SPI transaction per frame; >500 us of clock low latches it
+  return g_frames.tx.Configure(HAL_SINGLE_WS2801_DATA_PIN, HAL_SINGLE_WS2801_CLOCK_PIN, HAL_SINGLE_WS2801_CLOCK_HZ, 500);
 }
 
 inline void ClearLedHardware() {
-
+  memset(g_frames.Back(), 0, kLedCount * Format::kStride);
 }
 
 inline void SetPixelColor(uint16_t index, uint8_t r, uint8_t g, uint8_t b,
                           uint8_t w) {
   if (index >= kLedCount) return;
+  Format::Encode(g_frames.Back() + index * Format::kStride, r, g, b, w);
+}
 
+template<typename Pixel>
+inline void WriteFrame(const Pixel* pixels, uint16_t count) {
+  if (count > kLedCount) count = kLedCount;
+  Format::EncodeFrame(g_frames.Back(), pixels, count);
 }
 
-inline void ShowLedHardware() { }
+inline void ShowLedHardware() { g_frames.Present(); }
+
+inline bool IsShowComplete() { return g_frames.TransmissionComplete(); }
+
+inline const ShowStats& GetShowStats() { return g_frames.stats; }
 
 inline const char* GetHardwareConfigLabel() {
   return "HAL_CONFIG_SINGLE_WS2801";
@@ -268,6 +441,14 @@ inline void SetPixelColor(uint16_t index, uint8_t r, uint8_t g, uint8_t b, uint8
   }
 }
 
+template<typename Pixel>
+inline void WriteFrame(const Pixel* pixels, uint16_t count) {
+  // strips are interleaved pixel by pixel, so there is no contiguous block to copy
+  for (uint16_t i = 0; i < count; ++i) {
+    SetPixelColor(i, pixels[i].R, pixels[i].G, pixels[i].B, pixels[i].W);
+  }
+}
+
 
 inline void ShowLedHardware() {
   g_stripOne.show();
@@ -0,0 +1,338 @@
+//////////////////////////////////
+//    HAL FRAME TRANSMISSION    //
+//////////////////////////////////
+#pragma once
+#include <Arduino.h>
+#include <SPI.h>
+
+#if !defined(ARDUINO)
+#include <vector>
+#endif
+
+/**
+ * @file 055_HAL_SHOW.h
+ * @brief Frame buffers and transmitters behind HAL::ShowLedHardware().
+ *
+ * A profile keeps its wire-format frame in FrameBuffers<Transmitter, Bytes>.
+ * Present() hands the frame to the transmitter:
+ *  - HAL_ASYNC_SHOW 0: one buffer; Present() starts the transfer and waits
+ *    for it, like Adafruit_NeoPixel::show().
+ *  - HAL_ASYNC_SHOW 1: back and front buffer. Present() waits only if the
+ *    previous transfer still runs, swaps, starts the new front buffer in
+ *    the background and returns. The caller renders the next frame into the
+ *    back buffer (Back()) while the front one is on the wire.
+ *
+ * A transmitter provides Configure(...) (false if the peripheral could not be
+ * set up), Start(data, length), Busy(), Wait() and Torn(). Busy() covers the
+ * latch (reset) gap after the last bit, so a finished transfer means the
+ * strip has also taken the frame over. kSentOnStart tells whether the bytes
+ * are already out when Start() returns; then the blocking Present() does not
+ * wait for the latch, the next Present() does. Transmitters:
+ *  - MockTransmitter (host builds of the WS2812 profile, which has no bus
+ *    mock): takes bytes * 8 / bit rate + latch of micros(), which is virtual
+ *    time in the simulator. It copies every frame when it starts and checks
+ *    it when it ends; `torn` counts frames whose buffer changed mid-transfer.
+ *  - SpiTransmitter: WS2801 frame as one hardware SPI transaction; the
+ *    bytes leave in Start(), the latch runs in the background. On the host
+ *    the SPI mock (host/SPI.h) records the byte stream.
+ *  - RmtTransmitter (ESP32, HAL_ASYNC_SHOW only): WS2812 bit stream from the
+ *    RMT peripheral; the ISR translates the front buffer as it goes, so
+ *    nothing is copied. It uses the legacy driver/rmt.h, which arduino-esp32
+ *    3.x (ESP-IDF 5) does not allow next to the core's own RMT driver, so it
+ *    only exists on older cores (HAL_HAS_RMT_TRANSMITTER).
+ */
+
+// Frame transmission:
+//  0 = ShowLedHardware() blocks until the frame is on the wire
+//  1 = double-buffered: ShowLedHardware() swaps buffers, starts the transfer and
+//      returns; the next frame renders into the back buffer meanwhile (2x frame RAM)
+#ifndef HAL_ASYNC_SHOW
+#define HAL_ASYNC_SHOW 0
+#endif
+
+// RmtTransmitter is compiled for async ESP32 builds on arduino-esp32 < 3 only;
+// blocking builds never pull in the legacy RMT driver.
+#if defined(ARDUINO_ARCH_ESP32) && HAL_ASYNC_SHOW && \
+    !(defined(ESP_ARDUINO_VERSION_MAJOR) && ESP_ARDUINO_VERSION_MAJOR >= 3)
+#define HAL_HAS_RMT_TRANSMITTER 1
+#else
+#define HAL_HAS_RMT_TRANSMITTER 0
+#endif
+
+namespace HAL {
+
+/**
+ * @brief Counters of Present(): how often and how long it had to wait for the transmitter.
+ */
+struct ShowStats {
+  uint32_t frames = 0;     ///< frames started
+  uint32_t waits = 0;      ///< Present() calls that found the transmitter still busy with the previous frame
+  uint64_t waitUs = 0;     ///< total time spent in those waits
+  uint32_t maxWaitUs = 0;  ///< longest single wait
+  uint64_t sendUs = 0;     ///< HAL_ASYNC_SHOW 0: time a blocking Present() waited for its own frame to go out
+  uint32_t torn = 0;       ///< frames whose buffer changed while being sent (MockTransmitter only)
+};
+
+/**
+ * @brief Start time and length of the running transfer, latch included.
+ */
+struct TimedTransfer {
+  uint32_t bitRateHz = 800000;
+  uint32_t latchUs = 300;
+  uint32_t startUs = 0;
+  uint32_t durationUs = 0;
+  bool active = false;
+
+  void Begin(size_t length) {
+    startUs = micros();
+    durationUs = static_cast<uint32_t>((static_cast<uint64_t>(length) * 8u * 1000000u + bitRateHz - 1) / bitRateHz) + latchUs;
+    active = true;
+  }
+
+  uint32_t RemainingUs() const {
+    if (!active) return 0;
+    const uint32_t elapsed = micros() - startUs;
+    return (elapsed >= durationUs) ? 0 : durationUs - elapsed;
+  }
+};
+
+/**
+ * @brief Clocked strip (WS2801) on hardware SPI: the whole frame in one transaction.
+ *
+ * writeBytes() streams the frame through the SPI peripheral in one call and
+ * returns once the last byte is out. The strip latches after the clock has
+ * stayed low for latchUs; Busy() covers that gap, so with HAL_ASYNC_SHOW the
+ * latch overlaps the next render.
+ */
+struct SpiTransmitter {
+  static constexpr bool kSentOnStart = true;
+
+  SPIClass *spi = &SPI;
+  uint32_t clockHz = 1000000;
+  TimedTransfer transfer;
+
+  bool Configure(uint8_t dataPin, uint8_t clockPin, uint32_t clockHz, uint32_t latchUs) {
+    this->clockHz = clockHz;
+    transfer.latchUs = latchUs;
+#if defined(ARDUINO) && !defined(ARDUINO_ARCH_ESP32)
+    (void)dataPin;
+    (void)clockPin;
+    spi->begin();  // fixed hardware SPI pins
+#else
+    spi->begin(clockPin, -1, dataPin, -1);  // routed through the GPIO matrix, no MISO/CS
+#endif
+    return true;  // SPIClass::begin() reports nothing
+  }
+
+  void Start(const uint8_t *data, size_t length) {
+    spi->beginTransaction(SPISettings(clockHz, MSBFIRST, SPI_MODE0));
+    spi->writeBytes(data, static_cast<uint32_t>(length));
+    spi->endTransaction();
+    transfer.Begin(0);  // bytes are out, only the latch is left
+  }
+
+  bool Busy() {
+    if (transfer.active && transfer.RemainingUs() == 0) transfer.active = false;
+    return transfer.active;
+  }
+
+  void Wait() {
+    const uint32_t remaining = transfer.RemainingUs();
+    if (remaining > 0) delayMicroseconds(remaining);
+    transfer.active = false;
+  }
+
+  uint32_t Torn() const { return 0; }
+};
+
+#if !defined(ARDUINO)
+/**
+ * @brief Host stand-in for a DMA/RMT transmitter: simulated transfer time plus tear detection.
+ */
+struct MockTransmitter {
+  static constexpr bool kSentOnStart = false;
+
+  TimedTransfer transfer;
+  const uint8_t *data = nullptr;
+  std::vector<uint8_t> sent;  ///< copy of the frame taken when its transfer started
+  uint32_t frames = 0;        ///< completed transfers
+  uint32_t torn = 0;          ///< transfers whose buffer changed before they completed
+
+  bool Configure(uint8_t pin, uint32_t bitRateHz, uint32_t latchUs) {
+    (void)pin;
+    transfer.bitRateHz = bitRateHz;
+    transfer.latchUs = latchUs;
+    return true;
+  }
+
+  void Start(const uint8_t *bytes, size_t length) {
+    Finish();
+    data = bytes;
+    sent.assign(bytes, bytes + length);
+    transfer.Begin(length);
+  }
+
+  bool Busy() {
+    if (transfer.active && transfer.RemainingUs() == 0) Finish();
+    return transfer.active;
+  }
+
+  void Wait() {
+    const uint32_t remaining = transfer.RemainingUs();
+    if (remaining > 0) delayMicroseconds(remaining);
+    Finish();
+  }
+
+  uint32_t Torn() const { return torn; }
+
+ private:
+  void Finish() {
+    if (!transfer.active) return;
+    transfer.active = false;
+    ++frames;
+    if (memcmp(data, sent.data(), sent.size()) != 0) ++torn;
+  }
+};
+#endif
+
+#if HAL_HAS_RMT_TRANSMITTER
+}  // namespace HAL
+#include <driver/rmt.h>
+namespace HAL {
+
+/**
+ * @brief WS2812 bit stream on one RMT channel (legacy driver), sent without blocking.
+ *
+ * rmt_write_sample() with a translator reads the buffer from the ISR while
+ * it sends, so the buffer must stay untouched until Busy() is false; that
+ * is what the double buffer guarantees.
+ */
+struct RmtTransmitter {
+  static constexpr bool kSentOnStart = false;
+  static constexpr rmt_channel_t kChannel = RMT_CHANNEL_0;
+
+  TimedTransfer transfer;
+
+  /** @return false if the channel could not be configured, the driver installed or the translator set. */
+  bool Configure(uint8_t pin, uint32_t bitRateHz, uint32_t latchUs) {
+    transfer.bitRateHz = bitRateHz;
+    transfer.latchUs = latchUs;
+
+    rmt_config_t config = RMT_DEFAULT_CONFIG_TX(static_cast<gpio_num_t>(pin), kChannel);
+    config.clk_div = 2;  // 80 MHz APB -> 25 ns ticks
+    return rmt_config(&config) == ESP_OK
+           && rmt_driver_install(kChannel, 0, 0) == ESP_OK
+           && rmt_translator_init(kChannel, Translate) == ESP_OK;
+  }
+
+  void Start(const uint8_t *data, size_t length) {
+    transfer.Begin(length);
+    rmt_write_sample(kChannel, data, length, false);
+  }
+
+  bool Busy() {
+    if (!transfer.active) return false;
+    if (rmt_wait_tx_done(kChannel, 0) != ESP_OK || transfer.RemainingUs() > 0) return true;
+    transfer.active = false;
+    return false;
+  }
+
+  void Wait() {
+    if (!transfer.active) return;
+    rmt_wait_tx_done(kChannel, portMAX_DELAY);
+    const uint32_t remaining = transfer.RemainingUs();
+    if (remaining > 0) delayMicroseconds(remaining);
+    transfer.active = false;
+  }
+
+  uint32_t Torn() const { return 0; }
+
+  /**
+   * @brief Bytes -> RMT items, MSB first: 0 = 0.4 us high / 0.85 us low, 1 = 0.8 us high / 0.45 us low.
+   */
+  static void IRAM_ATTR Translate(const void *src, rmt_item32_t *dest, size_t srcSize, size_t wantedNum,
+                                  size_t *translatedSize, size_t *itemNum) {
+    if (src == nullptr || dest == nullptr) {
+      *translatedSize = 0;
+      *itemNum = 0;
+      return;
+    }
+    rmt_item32_t bit0, bit1;
+    bit0.level0 = 1; bit0.duration0 = 16; bit0.level1 = 0; bit0.duration1 = 34;
+    bit1.level0 = 1; bit1.duration0 = 32; bit1.level1 = 0; bit1.duration1 = 18;
+
+    const uint8_t *bytes = static_cast<const uint8_t *>(src);
+    size_t size = 0;
+    size_t num = 0;
+    while (size < srcSize && num + 8 <= wantedNum) {
+      for (uint8_t bit = 0; bit < 8; ++bit) {
+        dest[num++].val = (bytes[size] & (0x80 >> bit)) ? bit1.val : bit0.val;
+      }
+      ++size;
+    }
+    *translatedSize = size;
+    *itemNum = num;
+  }
+};
+#endif
+
+/**
+ * @brief Wire-format frame buffer(s) of one strip plus its transmitter.
+ */
+template<typename Transmitter, size_t Bytes>
+struct FrameBuffers {
+#if HAL_ASYNC_SHOW
+  uint8_t buffers[2][Bytes];
+  uint8_t back = 0;
+#else
+  uint8_t buffers[1][Bytes];
+  static constexpr uint8_t back = 0;
+#endif
+  Transmitter tx;
+  ShowStats stats;
+
+  /** The buffer to render into; with HAL_ASYNC_SHOW it changes on every Present(). */
+  uint8_t *Back() { return buffers[back]; }
+
+  /** True once the last presented frame is completely on the wire. */
+  bool TransmissionComplete() {
+    const bool complete = !tx.Busy();
+    stats.torn = tx.Torn();
+    return complete;
+  }
+
+  /**
+   * @brief Send the back buffer (see file comment for blocking vs. async).
+   */
+  void Present() {
+    WaitForTransmitter();
+#if HAL_ASYNC_SHOW
+    const uint8_t front = back;
+    back ^= 1;
+    tx.Start(buffers[front], Bytes);
+#else
+    tx.Start(buffers[0], Bytes);
+    if (!Transmitter::kSentOnStart) {
+      // the buffer is free once the bytes are out; part of the show, not a busy transmitter
+      const uint32_t startUs = micros();
+      tx.Wait();
+      stats.sendUs += micros() - startUs;
+    }
+#endif
+    ++stats.frames;
+    stats.torn = tx.Torn();
+  }
+
+ private:
+  void WaitForTransmitter() {
+    if (!tx.Busy()) return;
+    const uint32_t startUs = micros();
+    tx.Wait();
+    const uint32_t waitedUs = micros() - startUs;
+    ++stats.waits;
+    stats.waitUs += waitedUs;
+    if (waitedUs > stats.maxWaitUs) stats.maxWaitUs = waitedUs;
+  }
+};
+
+}  // namespace HAL
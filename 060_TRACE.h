@@ -0,0 +1,155 @@
+//////////////////////////////////
+//        EVENT TRACING         //
+//////////////////////////////////
+#pragma once
+#include <Arduino.h>
+#include <stdio.h>
+
+/**
+ * @file 060_TRACE.h
+ * @brief Fixed ring buffer of timed scopes, exported as Chrome trace JSON.
+ *
+ * TRACE::Scope marks a span of work (LED frame, effect tick, settings save,
+ * console command, mirror update, HomeSpan update() callbacks). It stores one
+ * record (start, duration, event) when the scope ends, so an overwritten
+ * record never leaves half a begin/end pair behind. Once the ring is full
+ * the oldest records are dropped and counted.
+ *
+ * WriteJson() emits the Chrome "complete event" format that chrome://tracing
+ * and ui.perfetto.dev open directly: DumpSerial() on the device (console
+ * command TRACE), WriteJsonFile() on the host.
+ *
+ * Scopes are recorded from loop() context only (HomeSpan calls update()
+ * from homeSpan.poll()), so the ring needs no locking.
+ */
+
+// Event tracing:
+//  0 = Scope compiles to nothing
+//  1 = record traced scopes into a ring of TRACE_CAPACITY events (12 bytes each)
+#ifndef TRACE_EVENTS
+#define TRACE_EVENTS 1
+#endif
+
+#ifndef TRACE_CAPACITY
+#define TRACE_CAPACITY 128
+#endif
+
+namespace TRACE {
+
+enum Event : uint8_t {
+  LED_FRAME,         ///< LED::Update() processing tick
+  LED_EFFECT,        ///< LED::Update() effect tick
+  SETTINGS_SAVE,     ///< Preferences flash write
+  CONSOLE_COMMAND,   ///< CONSOLE::EvaluateCommand()
+  MIRROR_UPDATED,    ///< MAIN::MirrorUpdated()
+  SERVICE_IDENTIFY,  ///< DEV_Identify::update()
+  SERVICE_COLOR1,    ///< DEV_Color1_Light::update()
+  SERVICE_COLOR2,    ///< DEV_Color2_Light::update()
+  EVENT_COUNT
+};
+
+inline constexpr const char* kEventNames[EVENT_COUNT] = {
+  "LED::Update frame", "LED::Update effect", "SETTINGS save", "CONSOLE command",
+  "MAIN::MirrorUpdated", "Identify update", "Color1 update", "Color2 update"
+};
+
+struct Record {
+  uint32_t startUs;
+  uint32_t durationUs;
+  Event event;
+};
+
+struct Ring {
+  Record records[TRACE_CAPACITY];
+  uint16_t head = 0;     ///< next slot to write
+  uint16_t count = 0;    ///< valid records, at most TRACE_CAPACITY
+  uint32_t dropped = 0;  ///< records overwritten since Clear()
+};
+
+inline Ring& GetRing() {
+  static Ring ring;
+  return ring;
+}
+
+inline void Clear() {
+  Ring &ring = GetRing();
+  ring.head = 0;
+  ring.count = 0;
+  ring.dropped = 0;
+}
+
+inline void Add(Event event, uint32_t startUs, uint32_t durationUs) {
+#if TRACE_EVENTS
+  Ring &ring = GetRing();
+  ring.records[ring.head] = Record{ startUs, durationUs, event };
+  ring.head = static_cast<uint16_t>((ring.head + 1) % TRACE_CAPACITY);
+  if (ring.count < TRACE_CAPACITY) {
+    ++ring.count;
+  } else {
+    ++ring.dropped;
+  }
+#else
+  (void)event;
+  (void)startUs;
+  (void)durationUs;
+#endif
+}
+
+/**
+ * @brief Records its own lifetime as one event.
+ */
+struct Scope {
+#if TRACE_EVENTS
+  explicit Scope(Event event) : event(event), startUs(micros()) {}
+  ~Scope() { Add(event, startUs, micros() - startUs); }
+
+  Event event;
+  uint32_t startUs;
+#else
+  explicit Scope(Event) {}
+#endif
+};
+
+/**
+ * @brief Write the ring, oldest first, as Chrome trace JSON through `sink(const char*)`.
+ */
+template<typename Sink>
+inline void WriteJson(Sink &&sink) {
+  const Ring &ring = GetRing();
+  char line[112];
+
+  sink("{\"traceEvents\":[\n");
+  const uint16_t first = static_cast<uint16_t>((ring.head + TRACE_CAPACITY - ring.count) % TRACE_CAPACITY);
+  for (uint16_t i = 0; i < ring.count; ++i) {
+    const Record &r = ring.records[(first + i) % TRACE_CAPACITY];
+    snprintf(line, sizeof(line), "%s{\"name\":\"%s\",\"ph\":\"X\",\"ts\":%lu,\"dur\":%lu,\"pid\":1,\"tid\":1}\n",
+             i ? "," : "", kEventNames[r.event],
+             static_cast<unsigned long>(r.startUs), static_cast<unsigned long>(r.durationUs));
+    sink(line);
+  }
+  snprintf(line, sizeof(line), "],\"displayTimeUnit\":\"ms\",\"otherData\":{\"dropped\":%lu}}\n",
+           static_cast<unsigned long>(ring.dropped));
+  sink(line);
+}
+
+/**
+ * @brief Print the trace JSON on Serial; paste it into a .json file to open it.
+ */
+inline void DumpSerial() {
+  WriteJson([](const char* text) { Serial.print(text); });
+}
+
+#if !defined(ARDUINO)
+/**
+ * @brief Write the trace JSON to `path`; false if the file cannot be opened.
+ */
+inline bool WriteJsonFile(const char* path) {
+  FILE* f = fopen(path, "w");
+  if (!f) return false;
+  WriteJson([f](const char* text) { fputs(text, f); });
+  fclose(f);
+  return true;
+}
+#endif
+
+}  // namespace TRACE
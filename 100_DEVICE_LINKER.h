@@ -6,6 +6,7 @@
 #include <Arduino.h>
 #include <math.h>
 
+#include "060_TRACE.h"
 #include "200_LED_LINKER.h"
 
 struct Mirror {
@@ -87,7 +88,10 @@ inline void ApplyCoreConfigToMirror() {
   mirror = sanitized;
 }
 
-inline void MirrorUpdated() { ApplyMirrorToCoreConfig(); }
+inline void MirrorUpdated() {
+  TRACE::Scope trace(TRACE::MIRROR_UPDATED);
+  ApplyMirrorToCoreConfig();
+}
 
 inline bool MirrorRgbwConversionEnabled() { return detail::RgbwConversionEnabled(); }
 
@@ -43,6 +43,7 @@ struct DEV_Identify : Service::AccessoryInformation {
   }
 
   boolean update() {
+    TRACE::Scope trace(TRACE::SERVICE_IDENTIFY);
 
     for (int i = 0; i < nBlinks; i++) {
       digitalWrite(homeSpan.getStatusPin(), LOW);
@@ -69,68 +70,26 @@ struct DEV_Color1_Light : Service::LightBulb {
   Characteristic::Saturation S{0,true};
   Characteristic::Brightness V{100,true};
 
-  WS2801_LED* pixel;
-  int nPixels;
-
-  uint32_t timer_RGB = 0;
-
-  WS2801_LED::Color* colors;
-
-DEV_Color1_Light(uint8_t dataPin, uint8_t clockPin, int count)
-  : Service::LightBulb(), nPixels(count) {
+  DEV_Color1_Light()
+    : Service::LightBulb() {
 
     V.setRange(5,100,1);                      // sets the range of the Brightness to be from a min of 5%, to a max of 100%, in steps of 1%
-    pixel=new WS2801_LED(dataPin,clockPin);          // creates Dot LED on specified pins
-    colors = new WS2801_LED::Color[nPixels];
 
-    //this->nPixels=nPixels;                    // save number of Pixels in this LED Strand
-    
-    update();                                 // manually call update() to set pixel with restored initial values
-    update();                                 // call second update() a second time - DotStar seems to need to be "refreshed" upon start-up
+    update();                                 // hand the restored values to the LED core
   }
 
   boolean update() override {
+    TRACE::Scope trace(TRACE::SERVICE_COLOR1);
 
-    int p = power.getNewVal();            // 0 or 1
-    float h = H.getNewVal<float>();       // [0..360]
-    float s = S.getNewVal<float>();       // [0..100]
-    float v = V.getNewVal<float>();       // [0..100]
-
-    WS2801_LED::Color c;
-    c.HSV(h * p, s * p, v * p);           // power=0 → black
-
-    for (int i = 0; i < nPixels; i++) {
-      colors[i] = c;
-    }
-
-    pixel->set(colors, nPixels);
-
-    mirror.onoff     = p;
-    mirror.level     = v;
-    mirror.hue1      = h;
-    mirror.sat1      = s;
+    mirror.onoff     = power.getNewVal();
+    mirror.level     = V.getNewVal();
+    mirror.hue1      = H.getNewVal<float>();
+    mirror.sat1      = S.getNewVal<float>();
 
     MAIN::MirrorUpdated();
 
     return true;
   }
-
-  void loop() override {
-    if (millis() - timer_RGB < 50)
-      return;
-
-    timer_RGB = millis();
-
-    // Example effect: faint blue pulse (only for demonstration)
-    static uint8_t pulse = 0;
-    pulse = (pulse + 1) % 255;
-
-    for (int i = 0; i < nPixels; i++) {
-      colors[i].RGB(0, 0, pulse);
-    }
-
-    pixel->set(colors, nPixels);
-  }
 };
 
 
@@ -224,6 +183,7 @@ struct DEV_Color2_Light : Service::LightBulb {
   }
 
   boolean update() {
+    TRACE::Scope trace(TRACE::SERVICE_COLOR2);
 
     //if (DEBUG_SERIAL) Serial.println("Update on RGB values (Color 2).");
 
@@ -260,7 +220,7 @@ bool InitializeDevice() {
   new Characteristic::Version(SKETCH_VERSION);
 
   // Two LightBulb services on the same accessory for the two colors
-  new DEV_Color1_Light(HAL_SINGLE_WS2801_DATA_PIN, HAL_SINGLE_WS2801_CLOCK_PIN, HAL_SINGLE_WS2801_LED_COUNT);
+  new DEV_Color1_Light();
   new DEV_Color2_Light();
 
   return true;
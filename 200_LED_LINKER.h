@@ -12,12 +12,19 @@
 
 ////////// Header Files //////////
 #include "050_HAL.h"
+#include "060_TRACE.h"
 
 #ifndef LED_COUNT
 #define LED_COUNT HAL::kLedCount
 #endif
 
+#ifndef LED_CORE_WIRE_FORMAT
+#define LED_CORE_WIRE_FORMAT HAL::Format
+#endif
+
 #include "210_LED_CORE.h"
+#include "230_LED_EFFECTS.h"
+#include "240_LED_STATS.h"
 
 
 
@@ -60,12 +67,31 @@ inline void Update();
 inline void UpdateColor();
 
 
+/**
+     * @brief HAL::ShowLedHardware(); a wire-output core then renders into the HAL's new back buffer.
+     */
+inline void ShowFrame();
+
+
 /**
      * @brief Set brightness (0–255).
      */
 inline void SetBrightness(uint8_t brightness);
 
 
+/**
+     * @brief Set the effect seed (0 = random at startup) and restart the effect from it.
+     */
+inline void SetEffectSeed(uint32_t seed);
+
+
+/**
+     * @brief Select the effect called `name` (see EFFECTS::kEffects).
+     * @return false if no such effect is registered.
+     */
+inline bool SetEffect(const char* name);
+
+
 enum SetTarget {
   BRIGHTNESS,
   COLOR_ONE,
@@ -76,6 +102,25 @@ bool Set(SetTarget target, const PixelByte& pix);
 bool Set(SetTarget target, uint8_t value);
 
 inline void Clear();
+
+
+/**
+     * @brief True while the render loop is parked (fades done, effect settled).
+     */
+inline bool IsIdle();
+
+
+/**
+     * @brief Leave the idle state; the next Update() fades, steps and renders again.
+     */
+inline void Wake();
+
+
+/**
+     * @brief Called with the core vars after every frame UpdateColor() pushed (host simulator); nullptr = none.
+     */
+using FrameObserver = void (*)(const Vars&);
+inline FrameObserver& OutputObserver();
 }
 
 /* -------------------------------------------------------------------------- */
@@ -95,13 +140,27 @@ inline void LED::ProvokeImmediateSaveOfConfig() {
 }
 
 inline bool LED::Init() {
+#if LED_CORE_WIRE_OUTPUT
+  // render straight into the driver's transmit buffer(s)
+  CORE::GetVars().Pixels.Attach(HAL::GetFrameBuffer(0), HAL::kFrameSplit, HAL::GetFrameBuffer(1));
+#endif
   if (!CORE::Init()) return false;
+  EFFECTS::Init();
+  STATS::Reset();
   if (!HAL::InitLedHardware()) return false;
   HAL::ClearLedHardware();
-  HAL::ShowLedHardware();
+  ShowFrame();
   return true;
 }
 
+inline void LED::ShowFrame() {
+  HAL::ShowLedHardware();
+#if LED_CORE_WIRE_OUTPUT
+  // with HAL_ASYNC_SHOW the show swapped buffers; the one just sent must not be touched
+  CORE::GetVars().Pixels.Attach(HAL::GetFrameBuffer(0), HAL::kFrameSplit, HAL::GetFrameBuffer(1));
+#endif
+}
+
 
 /**
  * @brief Update LED logic and push final RGBW values to hardware.
@@ -109,7 +168,31 @@ inline bool LED::Init() {
  * Sequence:
  *  1. Compute gradient or pattern into CORE::Vars::Colors[]
  *  2. Apply per-pixel scaling and logical brightness → CORE::Vars::Pixels[]
+ *     (1 and 2 run as a single pass with LED_CORE_FUSED)
  *  3. Write Pixels[] to hardware strip via UpdateColor()
+ *
+ * Steps 1-3 only run when State::renderDirty is set (Fade() moved something,
+ * the effect shifted a new scale in, or the config changed), so a static lamp
+ * does not recompute or call the HAL show at all.
+ *
+ * Fades and effects advance by the millis() elapsed since their last run, so
+ * processingIntervalMs/effectIntervalMs or late ticks change the update rate,
+ * not the speed of a transition.
+ *
+ * Once every fade reached its staging value and the effect is off and settled,
+ * step 6 parks the loop (State::idle): Update() returns immediately until
+ * MarkChangeInConfig(), MarkRenderDirty() or Wake() - HomeKit and console
+ * changes all end up there. IsIdle() tells the main loop it may sleep.
+ *
+ * With LED_CORE_DITHER a frame that left fractions behind keeps renderDirty
+ * set and the loop runs every LED_CORE_DITHER_INTERVAL_MS (if that is shorter),
+ * so the sigma-delta codes alternate fast enough to blend. That would keep a
+ * static colour with fractions from ever parking, so once fades and effect
+ * have been settled for LED_CORE_DITHER_SETTLE_MS, step 2b switches the output
+ * stage to plain rounding: the next frame has no fractions and step 6 parks.
+ * Anything that unsettles the scene turns dithering back on.
+ *
+ * Every stage is timed into STATS (240_LED_STATS.h, console command STATS).
  */
 inline void LED::Update() {
   //auto& state = CORE::GetState();
@@ -118,33 +201,93 @@ inline void LED::Update() {
   auto& s = CORE::GetState();
   auto& c = CORE::GetConfig();
 
-  if ((millis() - s.processingLastExecutionMs) > c.processingIntervalMs) {
+  // parked until MarkChangeInConfig()/MarkRenderDirty() or Wake()
+  if (s.idle) return;
+
+  const uint32_t now = millis();
+
+#if LED_CORE_DITHER
+  const uint32_t processingIntervalMs =
+    (CORE::GetVars().ditherPending && c.processingIntervalMs > LED_CORE_DITHER_INTERVAL_MS)
+      ? LED_CORE_DITHER_INTERVAL_MS
+      : c.processingIntervalMs;
+#else
+  const uint32_t processingIntervalMs = c.processingIntervalMs;
+#endif
+
+  if ((now - s.processingLastExecutionMs) > processingIntervalMs) {
+
+    TRACE::Scope trace(TRACE::LED_FRAME);
+    STATS::StageTimer frameTimer(STATS::FRAME);
 
     // --- Step 1: Update timing metadata ---
-    s.processingLastExecutionMs = millis();
+    const uint32_t elapsedMs = now - s.processingLastExecutionMs;
+    s.processingLastExecutionMs = now;
+    STATS::RecordTick(elapsedMs, processingIntervalMs);
+
+    // --- Step 2: Fade towards staging values by the time since the last frame ---
+    {
+      STATS::StageTimer timer(STATS::FADE);
+      if (CORE::Fade(elapsedMs) > 0) CORE::MarkRenderDirty();
+    }
+
+#if LED_CORE_DITHER
+    // --- Step 2b: Round plainly once the scene has been settled long enough ---
+    {
+      const bool settled = CORE::FadeSettled() && EFFECTS::IsSettled();
+      if (!settled) s.ditherSettledMs = now;
+      CORE::GetVars().ditherRounding = settled && (now - s.ditherSettledMs) >= LED_CORE_DITHER_SETTLE_MS;
+    }
+#endif
 
-    // --- Step 2: Update timing metadata ---
-    CORE::Fade();
-    
-    // --- Step 3: Compute color distribution (e.g., gradient) ---
-    CORE::ComputeGradient(c.gradientMode, c.gradientInvertColors);
+    if (s.renderDirty) {
+      s.renderDirty = false;
+
+      // --- Step 3+4: Compute color distribution (e.g., gradient), apply scaling and brightness ---
+#if LED_CORE_FUSED
+      {
+        STATS::StageTimer timer(STATS::RENDER);
+        CORE::RenderFrame(c.gradientMode, c.gradientInvertColors);
+      }
+#else
+      {
+        STATS::StageTimer timer(STATS::GRADIENT);
+        CORE::ComputeGradient(c.gradientMode, c.gradientInvertColors);
+      }
+      {
+        STATS::StageTimer timer(STATS::SCALING);
+        CORE::ApplyOutputScaling();
+      }
+#endif
+
+      // --- Step 5: Push to physical LEDs ---
+      {
+        STATS::StageTimer timer(STATS::SHOW);
+        UpdateColor();
+      }
 
-    // --- Step 4: Apply scaling and brightness ---
-    CORE::ApplyOutputScaling();
+#if LED_CORE_DITHER
+      // --- Step 5b: The next frame sends the carried fractions (none once rounding) ---
+      if (CORE::GetVars().ditherPending) s.renderDirty = true;
+#endif
+    }
 
-    // --- Step 5: Push to physical LEDs ---
-    UpdateColor();
+    // --- Step 6: Park once the frame is current and nothing is left to animate ---
+    if (!s.renderDirty && CORE::FadeSettled() && EFFECTS::IsSettled()) s.idle = true;
   }
 
   
 
-  if ((millis() - s.effectLastExecutionMs) > c.effectIntervalMs) {
+  if ((now - s.effectLastExecutionMs) > c.effectIntervalMs) {
 
     // --- Step 1: Update timing metadata ---
-    s.effectLastExecutionMs = millis();
+    const uint32_t elapsedMs = now - s.effectLastExecutionMs;
+    s.effectLastExecutionMs = now;
 
-    // --- Step 2: Update effect Function ---
-    CORE::Effect();
+    // --- Step 2: Advance the selected effect kernel by the elapsed time ---
+    TRACE::Scope trace(TRACE::LED_EFFECT);
+    STATS::StageTimer timer(STATS::EFFECT);
+    EFFECTS::Run(elapsedMs);
   }
 
 }
@@ -156,18 +299,31 @@ inline void LED::Update() {
  *
  * This function performs *only* the hardware write. It assumes CORE::Pixels
  * already contain final uint8_t values (0..255) and does not modify CORE state.
+ * The frame goes to HAL::WriteFrame() in one call; LED_CORE_SOA builds fall
+ * back to HAL::SetPixelColor() per pixel. With LED_CORE_WIRE_OUTPUT the output
+ * stage already wrote the driver's buffer, so only the show is left.
  */
 inline void LED::UpdateColor() {
   auto& v = CORE::GetVars();
   const size_t count = v.Count;
   if (count == 0) return;
 
+#if LED_CORE_WIRE_OUTPUT
+  // Pixels[] is the driver's buffer: the frame is already in wire order
+#elif LED_CORE_SOA
+  // planar buffer: no contiguous frame, fall back to one call per pixel
   for (size_t i = 0; i < count; ++i) {
-    const auto& p = v.Pixels[i];
-    //HAL::SetPixelColor(static_cast<uint16_t>(i), p.R, p.G, p.B, p.W);
+    const auto p = v.Pixels[i];
+    HAL::SetPixelColor(static_cast<uint16_t>(i), p.R, p.G, p.B, p.W);
   }
+#else
+  HAL::WriteFrame(v.Pixels, static_cast<uint16_t>(count));
+#endif
 
-  //HAL::ShowLedHardware();
+  // observe first: after the show a wire-output core points at the next back buffer
+  if (OutputObserver()) OutputObserver()(v);
+
+  ShowFrame();
 }
 
 
@@ -176,6 +332,14 @@ inline void LED::SetBrightness(uint8_t brightness) {
   CORE::SetStagingBrightness(brightness);
 }
 
+inline void LED::SetEffectSeed(uint32_t seed) {
+  EFFECTS::SetSeed(seed);
+}
+
+inline bool LED::SetEffect(const char* name) {
+  return EFFECTS::Select(EFFECTS::FindEffect(name));
+}
+
 
 
 /**
@@ -234,8 +398,17 @@ inline bool LED::Set(SetTarget target, uint8_t value) {
 
 
 
+inline bool LED::IsIdle() { return CORE::GetState().idle; }
+
+inline void LED::Wake() { CORE::Wake(); }
+
+inline LED::FrameObserver& LED::OutputObserver() {
+  static FrameObserver observer = nullptr;
+  return observer;
+}
+
 inline void LED::Clear() {
   CORE::Clear();
   HAL::ClearLedHardware();
-  HAL::ShowLedHardware();
+  ShowFrame();
 }
@@ -3,6 +3,8 @@
 //////////////////////////////////
 #pragma once
 #include <Arduino.h>
+#include "045_PIXEL_FORMAT.h"
+#include "220_GAMMA_TABLES.h"
 
 /**
  * @file LedCore.h
@@ -25,6 +27,101 @@
 #error "LED_COUNT must be defined before including LedCore.h"
 #endif
 
+// Render arithmetic:
+//  0 = float pipeline (reference)
+//  1 = integer pipeline (Q8.16 colors, Q24 blend weights, Q4.12 scales, Q16 output gain),
+//      matches the float pipeline within +/-1 LSB and avoids float work per pixel
+//      (worth it on FPU-less parts such as the ESP32-C3).
+#ifndef LED_CORE_FIXED_POINT
+#define LED_CORE_FIXED_POINT 0
+#endif
+
+// Pixel buffer layout of Vars::Pixels/Colors (Scale is always one ring per channel):
+//  0 = array of RGBW structs (AoS)
+//  1 = one contiguous plane per channel (SoA), so per-channel loops stream
+//      a single array; v.Pixels[i].R keeps working through a proxy
+#ifndef LED_CORE_SOA
+#define LED_CORE_SOA 0
+#endif
+
+// Frame rendering:
+//  0 = ComputeGradient() into Colors[], then ApplyOutputScaling() into Pixels[]
+//  1 = single fused pass (gradient, scale, brightness, on/off) straight into
+//      Pixels[]; Colors[] is not allocated
+#ifndef LED_CORE_FUSED
+#define LED_CORE_FUSED 0
+#endif
+
+// Color depth between gradient and output stage (Vars::Colors, RenderGradient):
+//  0 = 8 bit per channel; the gradient is truncated before scaling and brightness
+//  1 = Q8.8 per channel (2x Colors[] RAM); the only rounding to 8 bit is the final
+//      one in the output stage (or the Ditherer with LED_CORE_DITHER)
+#ifndef LED_CORE_WIDE_COLORS
+#define LED_CORE_WIDE_COLORS 0
+#endif
+
+// Output stage (brightness, on/off):
+//  0 = per-pixel multiply by brightness / 255 * onoffFactor
+//  1 = 256-entry lookup table per channel gamma(x * brightness / 255 * onoffFactor),
+//      rebuilt only when brightness or onoffFactor change
+#ifndef LED_CORE_OUTPUT_LUT
+#define LED_CORE_OUTPUT_LUT 0
+#endif
+
+// Temporal dithering of the output stage:
+//  0 = every channel is rounded to 8 bit each frame
+//  1 = the output stage keeps 8 fractional bits and each pixel carries its rounding
+//      error into the next frame (first-order sigma-delta), so a value of 3.25
+//      shows as 3,3,3,4,...; frames keep rendering every LED_CORE_DITHER_INTERVAL_MS
+//      while any fraction is left (4 bytes/pixel RAM)
+#ifndef LED_CORE_DITHER
+#define LED_CORE_DITHER 0
+#endif
+
+// How long a settled scene (fades done, effect off and settled) keeps dithering:
+// afterwards one frame is rounded plainly and LED::Update() parks. 0 = round as
+// soon as it settles, so dithering only smooths fades and effects and a static
+// colour shows its nearest 8-bit code instead of waking the loop forever.
+#ifndef LED_CORE_DITHER_SETTLE_MS
+#define LED_CORE_DITHER_SETTLE_MS 0
+#endif
+
+// Processing interval while dithering; the codes have to alternate fast enough to blend.
+#ifndef LED_CORE_DITHER_INTERVAL_MS
+#define LED_CORE_DITHER_INTERVAL_MS 4
+#endif
+
+// Output target of the frame (Vars::Pixels):
+//  0 = core-owned RGBW array; the linker hands it to the HAL, which packs it for the driver
+//  1 = view onto the driver's transmit buffer (attached with Pixels.Attach()), laid out
+//      as LED_CORE_WIRE_FORMAT; the output stage writes the bytes that go on the wire,
+//      nothing is copied or packed afterwards and no RGBW frame is allocated
+#ifndef LED_CORE_WIRE_OUTPUT
+#define LED_CORE_WIRE_OUTPUT 0
+#endif
+
+#if LED_CORE_WIRE_OUTPUT && LED_CORE_SOA
+#error "LED_CORE_WIRE_OUTPUT needs the AoS layout (LED_CORE_SOA 0): drivers send pixel by pixel"
+#endif
+
+// Gamma exponents of the lookup-table output stage (generated at compile time by
+// 220_GAMMA_TABLES.h); W defaults to the RGB curve but can be tuned on its own.
+#ifndef LED_CORE_GAMMA
+#define LED_CORE_GAMMA 2.2
+#endif
+#ifndef LED_CORE_GAMMA_R
+#define LED_CORE_GAMMA_R LED_CORE_GAMMA
+#endif
+#ifndef LED_CORE_GAMMA_G
+#define LED_CORE_GAMMA_G LED_CORE_GAMMA
+#endif
+#ifndef LED_CORE_GAMMA_B
+#define LED_CORE_GAMMA_B LED_CORE_GAMMA
+#endif
+#ifndef LED_CORE_GAMMA_W
+#define LED_CORE_GAMMA_W LED_CORE_GAMMA
+#endif
+
 
 
 namespace LED {
@@ -35,6 +132,8 @@ bool SetPixelRGBW(size_t index, uint8_t r, uint8_t g, uint8_t b, uint8_t w);
 
 void MarkChangeInConfig();
 void ProvokeImmediateSaveOfConfig();
+void MarkRenderDirty();
+void Wake();
 void ShiftScaleChannel(float newValue, int8_t channel, bool forward);
 
 /**
@@ -65,6 +164,17 @@ struct Pixel_byte {
   uint8_t W;
 };
 
+/**
+ * @brief Per-pixel representation (AoS) of 16-bit words (Q8.8 colors)
+ *
+ */
+struct Pixel_word {
+  uint16_t R;
+  uint16_t G;
+  uint16_t B;
+  uint16_t W;
+};
+
 /**
  * @brief Per-pixel representation (AoS) of floats
  *
@@ -77,21 +187,354 @@ struct Pixel_float {
 };
 
 
-struct Effect_Container {
-  float prev;
-  float next;
-  float currentOutput;
-  uint32_t numSteps;
-  uint32_t currentStep;
-  bool hold;
+/**
+ * @brief Storage type of one per-pixel scale factor (float, or Q4.12 in the fixed-point pipeline).
+ */
+#if LED_CORE_FIXED_POINT
+using ScaleSample = uint16_t;
+#else
+using ScaleSample = float;
+#endif
+
+/**
+ * @brief Per-channel scale history as ring buffers (one head offset per channel).
+ *
+ * Each ring is stored twice back to back (2 * N samples), so the `Length`
+ * samples of a channel, oldest-shifted order, are always readable as one
+ * contiguous window starting at Head[channel]. Shifting a new sample in moves
+ * the head and writes two slots instead of moving the whole array.
+ *
+ * Last/Run/Forward track the newest run of identical samples per channel, so a
+ * push can tell whether the window actually changed (it does not once a whole
+ * window of the same value has been shifted in).
+ */
+template<typename T, size_t N>
+struct ScaleRing {
+  T Samples[4][2 * N];
+  size_t Head[4];
+  size_t Length;
+
+  T Last[4];
+  size_t Run[4];
+  bool Forward[4];
+
+  /**
+   * Restart all four rings with `length` samples of `value`.
+   */
+  void Reset(size_t length, T value) {
+    Length = length;
+    for (uint8_t channel = 0; channel < 4; ++channel) {
+      Head[channel] = 0;
+      Last[channel] = value;
+      Run[channel] = length;
+      Forward[channel] = true;
+      for (size_t i = 0; i < 2 * length; ++i) Samples[channel][i] = value;
+    }
+  }
+
+  /**
+   * Window of `Length` samples of one channel: Window(c)[i] is the scale of pixel i.
+   */
+  const T *Window(uint8_t channel) const { return Samples[channel] + Head[channel]; }
+
+  /**
+   * Insert `sample` at pixel 0; every other pixel moves one up, the last one drops out.
+   * @return false if the window already held only `sample` (nothing changed).
+   */
+  bool PushFront(uint8_t channel, T sample) {
+    const bool changed = TrackRun(channel, sample, true);
+    size_t &head = Head[channel];
+    head = (head == 0) ? Length - 1 : head - 1;
+    Samples[channel][head] = sample;
+    Samples[channel][head + Length] = sample;
+    return changed;
+  }
+
+  /**
+   * Insert `sample` at pixel Length-1; every other pixel moves one down, pixel 0 drops out.
+   * @return false if the window already held only `sample` (nothing changed).
+   */
+  bool PushBack(uint8_t channel, T sample) {
+    const bool changed = TrackRun(channel, sample, false);
+    size_t &head = Head[channel];
+    Samples[channel][head] = sample;
+    Samples[channel][head + Length] = sample;
+    head = (head + 1 == Length) ? 0 : head + 1;
+    return changed;
+  }
+
+  /**
+   * Window of one channel for rewriting all `Length` samples in place (bulk effects).
+   * The mirrored half is left stale; call Mirror() before pushing into the channel again.
+   */
+  T *Overwrite(uint8_t channel) {
+    Head[channel] = 0;
+    Run[channel] = 0;  // content unknown: the next push reports a change
+    return Samples[channel];
+  }
+
+  /**
+   * Restore the mirrored half after Overwrite().
+   */
+  void Mirror(uint8_t channel) {
+    for (size_t i = 0; i < Length; ++i) Samples[channel][Length + i] = Samples[channel][i];
+  }
+
+  bool TrackRun(uint8_t channel, T sample, bool forward) {
+    const bool uniform = (Run[channel] >= Length);
+    const bool changed = !(uniform && sample == Last[channel]);
+
+    // a run only grows from one end; a uniform window is the same seen from either end
+    if (sample == Last[channel] && (forward == Forward[channel] || uniform)) {
+      if (Run[channel] < Length) ++Run[channel];
+    } else {
+      Last[channel] = sample;
+      Run[channel] = 1;
+    }
+    Forward[channel] = forward;
+    return changed;
+  }
+};
+
+
+/**
+ * @brief Per-pixel view (references into the four planes) of a PlanarBuffer.
+ */
+template<typename T>
+struct Pixel_ref {
+  T &R;
+  T &G;
+  T &B;
+  T &W;
+};
+
+/**
+ * @brief Per-channel planes (SoA) of N pixels.
+ *
+ * operator[] returns a Pixel_ref so pixel-wise code reads like the AoS arrays;
+ * kernels that work one channel at a time use Plane() instead.
+ */
+template<typename T, size_t N>
+struct PlanarBuffer {
+  T Planes[4][N];
+
+  Pixel_ref<T> operator[](size_t i) {
+    return { Planes[0][i], Planes[1][i], Planes[2][i], Planes[3][i] };
+  }
+
+  Pixel_ref<const T> operator[](size_t i) const {
+    return { Planes[0][i], Planes[1][i], Planes[2][i], Planes[3][i] };
+  }
+
+  T *Plane(uint8_t channel) { return Planes[channel]; }
+  const T *Plane(uint8_t channel) const { return Planes[channel]; }
+};
+
+// Wire format for LED_CORE_WIRE_OUTPUT: a PIXEL::Format<Order, White> from
+// 045_PIXEL_FORMAT.h (the LED linker passes the HAL profile's); GRBW by default.
+#ifndef LED_CORE_WIRE_FORMAT
+#define LED_CORE_WIRE_FORMAT PIXEL::Format<PIXEL::ORDER::GRBW, PIXEL::WHITE::Native>
+#endif
+
+/**
+ * @brief Pixels of up to N pixels living in one or two driver buffers, encoded as Format.
+ *
+ * Store() encodes a pixel through Format (color order and white handling
+ * fixed at compile time), so the output stage writes exactly what the
+ * driver sends. operator[] is a Pixel_ref onto the R/G/B/W bytes for
+ * everything else; on formats without a W byte, W reads and writes a
+ * scratch byte. A second segment covers profiles that chain two strips:
+ * pixels from `split` on go to the second buffer.
+ */
+template<typename Format, size_t N>
+struct WireBuffer {
+  using Order = typename Format::ColorOrder;
+  static constexpr uint8_t Stride = Format::kStride;
+
+  uint8_t *Segments[2] = { nullptr, nullptr };
+  size_t split = N;  ///< pixels in Segments[0]
+  uint8_t dropped = 0;  ///< W target of formats without a W byte
+
+  void Attach(uint8_t *first, size_t firstCount, uint8_t *second) {
+    Segments[0] = first;
+    Segments[1] = second;
+    split = second ? firstCount : N;
+  }
+
+  uint8_t *Bytes(size_t i) const {
+    return (i < split) ? Segments[0] + i * Stride : Segments[1] + (i - split) * Stride;
+  }
+
+  void Store(size_t i, uint8_t r, uint8_t g, uint8_t b, uint8_t w) { Format::Encode(Bytes(i), r, g, b, w); }
+
+  Pixel_ref<uint8_t> operator[](size_t i) {
+    uint8_t *p = Bytes(i);
+    if constexpr (Order::kHasWhite) {
+      return { p[Order::kR], p[Order::kG], p[Order::kB], p[Order::kW] };
+    } else {
+      return { p[Order::kR], p[Order::kG], p[Order::kB], dropped };
+    }
+  }
+
+  Pixel_ref<const uint8_t> operator[](size_t i) const {
+    const uint8_t *p = Bytes(i);
+    if constexpr (Order::kHasWhite) {
+      return { p[Order::kR], p[Order::kG], p[Order::kB], p[Order::kW] };
+    } else {
+      return { p[Order::kR], p[Order::kG], p[Order::kB], dropped };
+    }
+  }
+};
+
+#if LED_CORE_WIRE_OUTPUT
+using PixelBuffer = WireBuffer<LED_CORE_WIRE_FORMAT, LED_COUNT>;
+#elif LED_CORE_SOA
+using PixelBuffer = PlanarBuffer<uint8_t, LED_COUNT>;
+#else
+using PixelBuffer = Pixel_byte[LED_COUNT];
+#endif
+
+/**
+ * @brief One gradient color channel (8 bit, or Q8.8 with LED_CORE_WIDE_COLORS) and its buffer.
+ */
+#if LED_CORE_WIDE_COLORS
+using ColorSample = uint16_t;
+#if LED_CORE_SOA
+using ColorBuffer = PlanarBuffer<uint16_t, LED_COUNT>;
+#else
+using ColorBuffer = Pixel_word[LED_COUNT];
+#endif
+#else
+using ColorSample = uint8_t;
+#if LED_CORE_SOA
+using ColorBuffer = PlanarBuffer<uint8_t, LED_COUNT>;
+#else
+using ColorBuffer = Pixel_byte[LED_COUNT];
+#endif
+#endif
+
+/**
+ * @brief Pixels[i] = (r, g, b, w); with LED_CORE_WIRE_OUTPUT encoded through the wire format.
+ */
+inline void StorePixel(PixelBuffer &pixels, size_t i, uint8_t r, uint8_t g, uint8_t b, uint8_t w) {
+#if LED_CORE_WIRE_OUTPUT
+  pixels.Store(i, r, g, b, w);
+#else
+  auto &&px = pixels[i];
+  px.R = r;
+  px.G = g;
+  px.B = b;
+  px.W = w;
+#endif
+}
+
+
+/**
+ * @brief Per-pixel gradient blend weight (float, or Q24 in the fixed-point pipeline).
+ */
+#if LED_CORE_FIXED_POINT
+using GradientWeight = int32_t;
+#else
+using GradientWeight = float;
+#endif
+
+/**
+ * @brief How a run of pixels is filled from the (possibly inverted) primary/secondary colors.
+ */
+enum GradientSpanKind : uint8_t {
+  SPAN_PRIMARY = 0,         ///< Solid primary color.
+  SPAN_SECONDARY = 1,       ///< Solid secondary color.
+  SPAN_BLEND = 2,           ///< primary + (secondary - primary) * Weight[i]
+  SPAN_BLEND_REVERSED = 3,  ///< secondary + (primary - secondary) * Weight[i]
+};
+
+struct GradientSpan {
+  size_t begin;
+  size_t end;
+  GradientSpanKind kind;
+};
+
+/**
+ * @brief Position-dependent part of the gradient, cached between frames.
+ *
+ * Only depends on Count, the GradientMode and the gradient* Config fields
+ * (stored below as the cache key); UpdateGradientTable() rebuilds it when any
+ * of them changes. Colors and inversion are applied per frame.
+ */
+struct GradientTable {
+  bool valid = false;
+  size_t count = 0;
+  GradientMode mode = LINEAR;
+  float paddingBegin = 0.0f;
+  float paddingValue = 0.0f;
+  float middleEdgeSize = 0.0f;
+  float middleCenterSize = 0.0f;
+  InterpolationMode interpolationMode = InterpolationMode::Linear;
+
+  constexpr static uint8_t MaxSpans = 5;
+  uint8_t spanCount = 0;
+  GradientSpan Spans[MaxSpans];
+  GradientWeight Weight[LED_COUNT];
+};
+
+
+#if LED_CORE_OUTPUT_LUT
+/**
+ * @brief Per-channel gamma curves of the output stage (16 bit when dithering, so the dark end keeps its fractions).
+ */
+#if LED_CORE_DITHER
+inline constexpr GAMMA::ChannelCurves<uint16_t, 256> kOutputGamma =
+  GAMMA::MakeChannelGammaLut16(LED_CORE_GAMMA_R, LED_CORE_GAMMA_G, LED_CORE_GAMMA_B, LED_CORE_GAMMA_W);
+#else
+inline constexpr GAMMA::ChannelCurves<uint8_t, 256> kOutputGamma =
+  GAMMA::MakeChannelGammaLut8(LED_CORE_GAMMA_R, LED_CORE_GAMMA_G, LED_CORE_GAMMA_B, LED_CORE_GAMMA_W);
+#endif
+
+/**
+ * @brief Channel whose table channel c shares (first channel with the same exponent),
+ *        so equal curves are only built once per brightness change.
+ */
+constexpr uint8_t OutputCurveSource(uint8_t channel) {
+  const double exponents[4] = { LED_CORE_GAMMA_R, LED_CORE_GAMMA_G, LED_CORE_GAMMA_B, LED_CORE_GAMMA_W };
+  for (uint8_t c = 0; c < channel; ++c) {
+    if (exponents[c] == exponents[channel]) return c;
+  }
+  return channel;
+}
+
+/**
+ * @brief Output lookup table: Table[c][x] = gamma_c(x * brightness / 255 * onoffFactor).
+ *
+ * brightness/onoffFactor are the values the table was built for; see UpdateOutputLut().
+ * Only rows c with OutputCurveSource(c) == c are filled. Entries are 8 bit, or
+ * Q8.8 with LED_CORE_DITHER.
+ */
+struct OutputLut {
+#if LED_CORE_DITHER
+  using Entry = uint16_t;
+#else
+  using Entry = uint8_t;
+#endif
+
+  bool valid = false;
+  float brightness = 0.0f;
+  float onoffFactor = 0.0f;
+  Entry Table[4][256];
 };
+#endif
+
 
 /* --- Types --- */
 
 struct State {
   bool active = true;
+  bool renderDirty = true;  ///< Pixels[] is stale: fade, effect or config changed since the last frame
+  bool idle = false;        ///< parked: LED::Update() does nothing until Wake()
   uint32_t processingLastExecutionMs = 0;
   uint32_t effectLastExecutionMs = 0;
+#if LED_CORE_DITHER
+  uint32_t ditherSettledMs = 0;  ///< last frame at which fades or the effect still moved
+#endif
 };
 
 
@@ -102,12 +545,15 @@ struct Config {
   float brightnessStaging;
   float onoffStaging;
 
-  float colorIncrement = 1.0;
-  float brightnessIncrement = 1.0;
-  float onoffIncrement = 0.01;
+  // fade speeds in units per second (color/brightness 0..255, on/off 0..1); 0 = jump
+  float colorFadePerSecond = 100.0;
+  float brightnessFadePerSecond = 100.0;
+  float onoffFadePerSecond = 1.0;
 
   uint32_t processingIntervalMs = 10;
   uint32_t effectIntervalMs = 10;
+  // effect steps per second, independent of effectIntervalMs (one step = one pixel of travel)
+  float effectStepsPerSecond = 100.0;
 
   // Gradient Mode LINEAR_PADDING
   // can be between 0.0 and 0.4 - will start linear blend (is mirrored for the other color)
@@ -136,11 +582,22 @@ struct Config {
   float effectHoldMinSteps = 10;
   float effectHoldMaxSteps = 30;
 
+  // NOISE effect: size of one noise cell in pixels (>= 1) and drift speed in cells per second
+  float effectNoiseScale = 16;
+  float effectNoiseSpeed = 0.4;
+
   bool effectActive = true;
 
+  // seed of the effect generator; lamps with the same seed play the same effect.
+  // 0 = pick a random seed at startup
+  uint32_t effectSeed = 0;
+
+  // index of the running effect in LED::EFFECTS::kEffects (see 230_LED_EFFECTS.h)
+  uint8_t effectIndex = 0;
 
 
-  uint8_t count = LED_COUNT;
+
+  uint16_t count = LED_COUNT;
 
   // following var are used to save the settings
   uint32_t changeCounter = 0;   // persistent
@@ -151,11 +608,13 @@ struct Config {
 
 
 struct Vars {
-  Pixel_byte Pixels[LED_COUNT];
-  Pixel_byte Colors[LED_COUNT];
-  Pixel_float Scale[LED_COUNT];
+  PixelBuffer Pixels;
+#if !LED_CORE_FUSED
+  ColorBuffer Colors;
+#endif
+  ScaleRing<ScaleSample, LED_COUNT> Scale;
 
-  // computed end-values, from which Colors[] is built
+  // computed end-values, from which the gradient is built
   Pixel_float colorOne;
   Pixel_float colorTwo;
 
@@ -165,7 +624,17 @@ struct Vars {
   constexpr static size_t Capacity = LED_COUNT;
   size_t Count = Capacity;
 
-  Effect_Container Effect[4];
+  GradientTable Gradient;
+#if LED_CORE_OUTPUT_LUT
+  OutputLut Output;
+#endif
+
+#if LED_CORE_DITHER
+  uint8_t DitherError[4][LED_COUNT];  ///< per channel and pixel: rounding error carried to the next frame (Q0.8)
+  bool ditherPending = false;         ///< the last frame had fractions, so the next one differs
+  bool ditherRounding = false;        ///< round plainly instead of dithering (settled scene, see LED_CORE_DITHER_SETTLE_MS)
+#endif
+
 };
 
 /* compile-time sanity */
@@ -173,6 +642,140 @@ static_assert(Vars::Capacity > 0, "LED_COUNT must be > 0");
 
 
 
+/* --- Fixed-point helpers --- */
+
+/**
+ * Convert a scale factor (1.0 = unchanged) into its storage representation.
+ */
+inline ScaleSample ToScaleSample(float value) {
+#if LED_CORE_FIXED_POINT
+  value = constrain(value, 0.0f, 15.999f);
+  return static_cast<ScaleSample>(value * 4096.0f + 0.5f);
+#else
+  return value;
+#endif
+}
+
+/**
+ * Convert a stored scale sample back into its scale factor.
+ */
+inline float FromScaleSample(ScaleSample sample) {
+#if LED_CORE_FIXED_POINT
+  return static_cast<float>(sample) * (1.0f / 4096.0f);
+#else
+  return sample;
+#endif
+}
+
+/**
+ * Float gradient color in [0, 255] -> ColorSample (truncated to 8 bit, or rounded to Q8.8).
+ */
+inline ColorSample ToColorSample(float value) {
+#if LED_CORE_WIDE_COLORS
+  return static_cast<ColorSample>(value * 256.0f + 0.5f);
+#else
+  return static_cast<ColorSample>(value);
+#endif
+}
+
+#if LED_CORE_FIXED_POINT
+namespace FIXED {
+
+constexpr int32_t kWeightOne = 1 << 24;      ///< Q24 blend weight 1.0
+constexpr int64_t kRampOne = 1LL << 40;      ///< Q40 ramp accumulator 1.0 (steps weights along the strip)
+constexpr uint32_t kColorMax = 255u << 8;    ///< Q8.8 255.0
+constexpr uint32_t kGainOne = 1u << 16;      ///< Q16 output gain 1.0
+constexpr int32_t kTruncationSlack = 16;     ///< Q8.16 2^-12: covers the quantization error of a blend
+
+/**
+ * @brief Color in Q8.16 per channel.
+ *
+ * 16 fractional bits hold every float color in [1, 255] exactly, and rounding a
+ * blend to this grid reproduces the float pipeline's final rounding step closely
+ * enough that the uint8_t truncation in Colors[] lands on the same side.
+ */
+struct Pixel_q16 {
+  int32_t R;
+  int32_t G;
+  int32_t B;
+  int32_t W;
+};
+
+inline int32_t ColorFromFloat(float value) {
+  value = constrain(value, 0.0f, 255.0f);
+  return static_cast<int32_t>(lroundf(value * 65536.0f));
+}
+
+inline Pixel_q16 ColorFromPixel(const Pixel_float &pix) {
+  return { ColorFromFloat(pix.R), ColorFromFloat(pix.G), ColorFromFloat(pix.B), ColorFromFloat(pix.W) };
+}
+
+/**
+ * Float weight -> Q40 ramp value. Only used once per frame to seed weight ramps.
+ */
+inline int64_t RampFromFloat(float value) {
+  return static_cast<int64_t>(llroundf(value * 1099511627776.0f));  // 2^40
+}
+
+/**
+ * Q40 ramp value -> Q24 weight, clamped to [0, 1].
+ */
+inline int32_t WeightFromRamp(int64_t ramp) {
+  if (ramp <= 0) return 0;
+  if (ramp >= kRampOne) return kWeightOne;
+  return static_cast<int32_t>((ramp + (1LL << 15)) >> 16);
+}
+
+/**
+ * Smoothstep t*t*(3-2t) on a Q24 weight.
+ */
+inline int32_t Smoothstep(int32_t t) {
+  const int64_t t2 = (static_cast<int64_t>(t) * t + (1LL << 23)) >> 24;
+  return static_cast<int32_t>((t2 * (3LL * kWeightOne - 2LL * t) + (1LL << 23)) >> 24);
+}
+
+/**
+ * Q8.16 channel -> ColorSample (truncated to 8 bit, or rounded to Q8.8 with LED_CORE_WIDE_COLORS).
+ *
+ * A blend whose exact value is a whole code (200.4 -> 143.0) can land a few
+ * Q16 units below it; the float pipeline truncates the exact value to 143, a
+ * bare >> 16 would give 142, and an effect scale above 1.0 turns that code
+ * into 2 LSB at the output. kTruncationSlack lifts such values over the edge.
+ */
+inline ColorSample ToColorSample(int32_t value) {
+#if LED_CORE_WIDE_COLORS
+  return static_cast<ColorSample>((value + 0x80) >> 8);
+#else
+  return static_cast<ColorSample>((value + kTruncationSlack) >> 16);
+#endif
+}
+
+/**
+ * Blend two Q8.16 channels with a Q24 weight and return the result as ColorSample.
+ */
+inline ColorSample Blend(int32_t a, int32_t b, int32_t w) {
+  const int64_t delta = static_cast<int64_t>(b - a) * w;
+  return ToColorSample(a + static_cast<int32_t>((delta + (1LL << 23)) >> 24));
+}
+
+/**
+ * Number of pixels i in [0, n) whose position i/(n-1) is <= edge (inclusive = true) or < edge.
+ */
+inline size_t CountPositionsBelow(float edge, size_t n, bool inclusive) {
+  if (n <= 1) return (inclusive ? 0.0f <= edge : 0.0f < edge) ? n : 0;
+  const float idx = edge * static_cast<float>(n - 1);
+  if (idx < 0.0f) return 0;
+  long count = inclusive ? static_cast<long>(floorf(idx)) + 1 : static_cast<long>(ceilf(idx));
+  if (count < 0) count = 0;
+  if (count > static_cast<long>(n)) count = static_cast<long>(n);
+  return static_cast<size_t>(count);
+}
+
+}  // namespace FIXED
+#endif
+
+
+
 /* --- Singletons (function-local statics) --- */
 
 /**
@@ -214,6 +817,8 @@ inline bool Init() {
   c.brightnessStaging = 255.0;
   c.onoffStaging = 1.0f;
   s.active = true;
+  s.renderDirty = true;
+  s.idle = false;
   s.processingLastExecutionMs = millis();
   s.effectLastExecutionMs = millis();
 
@@ -223,17 +828,23 @@ inline bool Init() {
     v.Pixels[i].B = 0;
     v.Pixels[i].W = 0;
 
+#if !LED_CORE_FUSED
     v.Colors[i].R = 0;
     v.Colors[i].G = 0;
     v.Colors[i].B = 0;
     v.Colors[i].W = 0;
+#endif
 
-    v.Scale[i].R = 1.0;
-    v.Scale[i].G = 1.0;
-    v.Scale[i].B = 1.0;
-    v.Scale[i].W = 1.0;
   }
 
+  v.Scale.Reset(v.Count, ToScaleSample(1.0f));
+
+#if LED_CORE_DITHER
+  memset(v.DitherError, 0x80, sizeof(v.DitherError));  // half a code: the first frame rounds like the plain stage
+  v.ditherPending = false;
+  v.ditherRounding = false;
+#endif
+
   v.colorOne.R = 0.0;
   v.colorOne.G = 0.0;
   v.colorOne.B = 0.0;
@@ -256,99 +867,11 @@ inline bool Init() {
   c.colorTwoStaging.B = 0.0;
   c.colorTwoStaging.W = 0.0;
 
-
-  for (int n = 0; n < 4; n++) {
-    v.Effect[n].prev = 1.0;
-    v.Effect[n].next = 1.0;
-    v.Effect[n].currentOutput = 1.0;
-    v.Effect[n].numSteps = 0;
-    v.Effect[n].currentStep = 1;
-    v.Effect[n].hold = 0;
-  }
-
   return true;
 }
 
 
 
-/**
- * Effect Handler function.
- */
-inline void Effect() {
-
-  Vars &v = GetVars();
-  Config &c = GetConfig();
-
-  auto randomInt = [](int x, int y) {
-    return random(x, y + 1);
-  };
-
-  auto randomFloat = [](float minValue, float maxValue) {
-    const float r = static_cast<float>(rand()) / static_cast<float>(RAND_MAX);
-    return minValue + r * (maxValue - minValue);
-  };
-
-  auto mapFloatToFloat = [](float x, float x0, float x1, float y0, float y1) {
-    if (x <= x0) return y0;
-    if (x >= x1) return y1;
-    const float t = (x - x0) / (x1 - x0);
-    return y0 + t * (y1 - y0);
-  };
-
-  auto applySmoothInterpolation = [](float t) {
-    t = constrain(t, 0.0f, 1.0f);
-    return t * t * (3.0f - 2.0f * t);
-  };
-
-
-  if (c.effectActive) {
-
-    for (int n = 0; n < 4; n++) {
-      if (v.Effect[n].currentStep > v.Effect[n].numSteps) {
-        v.Effect[n].prev = v.Effect[n].next;
-
-        if (v.Effect[n].hold) {
-          v.Effect[n].numSteps = randomInt(c.effectHoldMinSteps, c.effectHoldMaxSteps);
-
-          v.Effect[n].hold = !v.Effect[n].hold;
-        } else {
-          v.Effect[n].next = randomFloat(c.effectMinAmplitude, c.effectMaxAmplitude);
-          float diff = v.Effect[n].next - v.Effect[n].prev;
-          float diffMappedSteps = mapFloatToFloat(diff, c.effectMinAmplitude, c.effectMaxAmplitude, c.effectEvolveMinSteps, c.effectEvolveMaxSteps);
-
-          v.Effect[n].numSteps = (uint32_t)(diffMappedSteps * randomFloat(0.8, 1.2));
-
-          v.Effect[n].hold = !v.Effect[n].hold;
-        }
-
-        v.Effect[n].currentStep = 0;
-      }
-
-      float diff = v.Effect[n].next - v.Effect[n].prev;
-      float progress = (float)v.Effect[n].currentStep / (float)v.Effect[n].numSteps;
-      v.Effect[n].currentOutput = v.Effect[n].prev + applySmoothInterpolation(progress) * diff;
-
-
-      ++v.Effect[n].currentStep;
-    }
-
-    ShiftScaleChannel(v.Effect[0].currentOutput, 0, true);
-    ShiftScaleChannel(v.Effect[1].currentOutput, 1, false);
-    ShiftScaleChannel(v.Effect[2].currentOutput, 2, true);
-    ShiftScaleChannel(v.Effect[3].currentOutput, 3, false);
-  } else {
-
-    for (int n = 0; n < 4; n++) {
-      ShiftScaleChannel(1.0, 0, true);
-    }
-  }
-  //Serial.println(v.Effect.currentOutput);
-}
-
-
-
-
-
 /**
  * Set logical brightness (0..255).
  */
@@ -389,24 +912,31 @@ inline float StepTowards(float current, float target, float step) {
 
 
 /**
- * @brief Perform fading (one step) of brightness and the two color-sets towards staging values.
+ * @brief Fade brightness, on/off and the two color-sets towards their staging values
+ *        by the distance covered in `elapsedMs`.
  *
- * - Applies `brightnessIncrement` to brightness staging.
- * - Applies `colorIncrement` to each RGBA channel of colorOne and colorTwo.
+ * - Moves brightness by `brightnessFadePerSecond`, on/off by `onoffFadePerSecond`
+ *   and each RGBW channel of colorOne and colorTwo by `colorFadePerSecond`.
  * - Clamps resulting channels to [0.0f, 255.0f].
  *
+ * A fade therefore takes the same time at any frame rate or with dropped frames.
+ *
  * @return Number of channels that changed during this call (0 = no change / finished).
  */
-inline uint8_t Fade() {
+inline uint8_t Fade(uint32_t elapsedMs) {
   auto &c = GetConfig();
   auto &v = GetVars();
 
   uint8_t changes = 0;
+  if (elapsedMs == 0) return changes;
+
+  const float seconds = static_cast<float>(elapsedMs) * 0.001f;
+  const float colorStep = c.colorFadePerSecond * seconds;
 
   // brightness (float)
   {
     const float prev = v.brightness;
-    v.brightness = StepTowards(prev, c.brightnessStaging, c.brightnessIncrement);
+    v.brightness = StepTowards(prev, c.brightnessStaging, c.brightnessFadePerSecond * seconds);
     v.brightness = constrain(v.brightness, 0.0f, 255.0f);
     if (fabsf(v.brightness - prev) > 1e-5f) ++changes;
   }
@@ -414,7 +944,7 @@ inline uint8_t Fade() {
   // on/off fade factor (0..1)
   {
     const float prev = v.onoffFactor;
-    v.onoffFactor = StepTowards(prev, c.onoffStaging, c.onoffIncrement);
+    v.onoffFactor = StepTowards(prev, c.onoffStaging, c.onoffFadePerSecond * seconds);
     v.onoffFactor = constrain(v.onoffFactor, 0.0f, 1.0f);
     if (fabsf(v.onoffFactor - prev) > 1e-5f) ++changes;
   }
@@ -422,7 +952,7 @@ inline uint8_t Fade() {
   // helper lambda to step & clamp a single channel and count change
   auto stepChannel = [&](float &channel, float target) {
     const float prev = channel;
-    channel = StepTowards(prev, target, c.colorIncrement);
+    channel = StepTowards(prev, target, colorStep);
     channel = constrain(channel, 0.0f, 255.0f);
     if (fabsf(channel - prev) > 1e-5f) ++changes;
   };
@@ -445,220 +975,795 @@ inline uint8_t Fade() {
 
 
 
-inline void ComputeGradient(GradientMode mode, bool invertColors) {
+/**
+ * @brief True when brightness, on/off and both colors sit exactly on their staging values.
+ */
+inline bool FadeSettled() {
+  const auto &c = GetConfig();
+  const auto &v = GetVars();
+
+  // Fade() clamps while stepping, so compare against the clamped target
+  auto same = [](const Pixel_float &a, const Pixel_float &b) {
+    return a.R == constrain(b.R, 0.0f, 255.0f) && a.G == constrain(b.G, 0.0f, 255.0f)
+           && a.B == constrain(b.B, 0.0f, 255.0f) && a.W == constrain(b.W, 0.0f, 255.0f);
+  };
+
+  return v.brightness == constrain(c.brightnessStaging, 0.0f, 255.0f)
+         && v.onoffFactor == constrain(c.onoffStaging, 0.0f, 1.0f)
+         && same(v.colorOne, c.colorOneStaging)
+         && same(v.colorTwo, c.colorTwoStaging);
+}
+
+
+
+#if LED_CORE_OUTPUT_LUT
+/**
+ * @brief Return the output tables, rebuilding them if brightness or onoffFactor changed.
+ *
+ * The gain is applied in Q16 before the gamma curve, so fades dim in the
+ * linear domain and the curve makes the steps perceptually even. Table values
+ * between two gamma entries are interpolated.
+ */
+inline const OutputLut &UpdateOutputLut() {
   auto &v = GetVars();
+  OutputLut &lut = v.Output;
 
-  if (v.Count == 0) return;
+  if (lut.valid && lut.brightness == v.brightness && lut.onoffFactor == v.onoffFactor) return lut;
+
+  lut.valid = true;
+  lut.brightness = v.brightness;
+  lut.onoffFactor = v.onoffFactor;
+
+  const float brightnessNorm = constrain(v.brightness, 0.0f, 255.0f) / 255.0f;
+  const float gainNorm = constrain(brightnessNorm * v.onoffFactor, 0.0f, 1.0f);
+  const uint32_t gain = static_cast<uint32_t>(gainNorm * 65536.0f + 0.5f);  // Q16
+
+  for (uint8_t channel = 0; channel < 4; ++channel) {
+    if (OutputCurveSource(channel) != channel) continue;
+
+    const auto &gamma = kOutputGamma[channel];
+    OutputLut::Entry *table = lut.Table[channel];
+    for (uint32_t x = 0; x < 256; ++x) {
+      const uint32_t position = x * gain;  // Q8.16 index into the gamma table
+      const uint32_t index = position >> 16;
+      const uint32_t frac = position & 0xFFFFu;
+#if LED_CORE_DITHER
+      const int64_t lo = gamma[index];
+      const int64_t hi = gamma[index < 255 ? index + 1 : 255];
+      const int64_t value = lo + (((hi - lo) * static_cast<int64_t>(frac) + 0x8000) >> 16);
+      table[x] = static_cast<OutputLut::Entry>((value * 256 + 128) / 257);  // 0..65535 -> Q8.8 0..255.0
+#else
+      const int32_t lo = gamma[index];
+      const int32_t hi = gamma[index < 255 ? index + 1 : 255];
+      table[x] = static_cast<OutputLut::Entry>(lo + (((hi - lo) * static_cast<int32_t>(frac) + 0x8000) >> 16));
+#endif
+    }
+  }
+  return lut;
+}
+#endif
+
+
+/**
+ * @brief Output stage for one channel: color * scale * (brightness / 255) * onoffFactor, rounded.
+ *
+ * Float: the scaled color is clamped to [0, 255] before the global factors.
+ * Fixed: color (8 bit, or Q8.8 with LED_CORE_WIDE_COLORS) times scale (Q4.12)
+ * is reduced to Q8.8 and clamped to 255.0, then multiplied by a Q16 gain and rounded.
+ * LED_CORE_OUTPUT_LUT: the scaled color is clamped and rounded to 8 bit, and
+ * the global factors and gamma come from one OutputLut lookup; wide colors
+ * interpolate between neighbouring entries instead of rounding.
+ * LED_CORE_DITHER: Wide() returns the unrounded result in Q8.8 (at most
+ * 255.0) for a Ditherer instead.
+ *
+ * Build one per channel and frame with MakeChannelScaler().
+ */
+struct ChannelScaler {
+#if LED_CORE_FIXED_POINT
+  /** color * scale in Q8.8, clamped to 255.0 */
+  static uint32_t Scaled(ColorSample color, ScaleSample scale) {
+#if LED_CORE_WIDE_COLORS
+    uint32_t scaled = (static_cast<uint32_t>(color) * scale + (1u << 11)) >> 12;
+#else
+    uint32_t scaled = (static_cast<uint32_t>(color) * scale) >> 4;
+#endif
+    if (scaled > FIXED::kColorMax) scaled = FIXED::kColorMax;
+    return scaled;
+  }
+#else
+  /** color * scale, clamped to [0, 255] */
+  static float Scaled(ColorSample color, ScaleSample scale) {
+#if LED_CORE_WIDE_COLORS
+    const float scaled = static_cast<float>(color) * (1.0f / 256.0f) * scale;
+#else
+    const float scaled = static_cast<float>(color) * scale;
+#endif
+    return constrain(scaled, 0.0f, 255.0f);
+  }
+#endif
+
+#if LED_CORE_OUTPUT_LUT
+  const OutputLut::Entry *table;
+
+#if LED_CORE_WIDE_COLORS
+  OutputLut::Entry Lookup(ColorSample color, ScaleSample scale) const {
+#if LED_CORE_FIXED_POINT
+    const uint32_t position = Scaled(color, scale);
+#else
+    const uint32_t position = static_cast<uint32_t>(Scaled(color, scale) * 256.0f + 0.5f);
+#endif
+    const uint32_t index = position >> 8;
+    const int32_t lo = table[index];
+    const int32_t hi = table[index < 255 ? index + 1 : 255];
+    return static_cast<OutputLut::Entry>(lo + (((hi - lo) * static_cast<int32_t>(position & 0xFFu) + 0x80) >> 8));
+  }
+#elif LED_CORE_FIXED_POINT
+  OutputLut::Entry Lookup(ColorSample color, ScaleSample scale) const {
+    return table[(Scaled(color, scale) + 0x80u) >> 8];
+  }
+#else
+  OutputLut::Entry Lookup(ColorSample color, ScaleSample scale) const {
+    return table[static_cast<int>(Scaled(color, scale) + 0.5f)];
+  }
+#endif
+
+#if LED_CORE_DITHER
+  uint16_t Wide(ColorSample color, ScaleSample scale) const { return Lookup(color, scale); }
+#else
+  uint8_t operator()(ColorSample color, ScaleSample scale) const { return Lookup(color, scale); }
+#endif
+
+#elif LED_CORE_FIXED_POINT
+  uint32_t gain;
+
+#if LED_CORE_DITHER
+  uint16_t Wide(ColorSample color, ScaleSample scale) const {
+    return static_cast<uint16_t>((Scaled(color, scale) * gain + (1u << 15)) >> 16);
+  }
+#else
+  uint8_t operator()(ColorSample color, ScaleSample scale) const {
+    return static_cast<uint8_t>((Scaled(color, scale) * gain + (1u << 23)) >> 24);
+  }
+#endif
+#else
+  float brightnessNorm;
+  float onOff;
+
+#if LED_CORE_DITHER
+  uint16_t Wide(ColorSample color, ScaleSample scale) const {
+    const float scaledOut = Scaled(color, scale) * brightnessNorm * onOff;
+
+    const int value = static_cast<int>(scaledOut * 256.0f + 0.5f);
+    return static_cast<uint16_t>(constrain(value, 0, 255 * 256));
+  }
+#else
+  uint8_t operator()(ColorSample color, ScaleSample scale) const {
+    const float scaledOut = Scaled(color, scale) * brightnessNorm * onOff;
+
+    const int value = static_cast<int>(scaledOut + 0.5f);
+    return static_cast<uint8_t>(constrain(value, 0, 255));
+  }
+#endif
+#endif
+};
+
+#if LED_CORE_DITHER
+/**
+ * @brief First-order sigma-delta quantizer from Q8.8 to 8 bit.
+ *
+ * Adds the pixel's carried error to the fraction; the integer part plus the
+ * carry is sent, the new fraction stays in `error`. Over 256 frames the sent
+ * codes average exactly the Q8.8 input. Values are at most 255.0, whose
+ * fraction is 0, so the carry never overflows. `fractions` stays 0 while
+ * every value of the frame is a whole code. With `round` set it rounds to
+ * the nearest code, leaves the error alone and reports no fractions.
+ */
+struct Ditherer {
+  bool round = false;
+  uint8_t fractions = 0;
+
+  uint8_t operator()(uint16_t value, uint8_t &error) {
+    if (round) return static_cast<uint8_t>((value + 0x80) >> 8);
+    const uint8_t fraction = static_cast<uint8_t>(value);
+    const uint16_t sum = static_cast<uint16_t>(fraction + error);
+    fractions |= fraction;
+    error = static_cast<uint8_t>(sum);
+    return static_cast<uint8_t>((value >> 8) + (sum >> 8));
+  }
+};
+#endif
+
+inline ChannelScaler MakeChannelScaler(uint8_t channel) {
+#if LED_CORE_OUTPUT_LUT
+  return { UpdateOutputLut().Table[OutputCurveSource(channel)] };
+#else
+  (void)channel;
+  auto &v = GetVars();
+
+  const float brightnessNorm = constrain(v.brightness, 0.0f, 255.0f) / 255.0f;
+#if LED_CORE_FIXED_POINT
+  const float gainNorm = constrain(brightnessNorm * v.onoffFactor, 0.0f, 1.0f);
+  return { static_cast<uint32_t>(gainNorm * static_cast<float>(FIXED::kGainOne) + 0.5f) };
+#else
+  return { brightnessNorm, v.onoffFactor };
+#endif
+#endif
+}
+
+
+#if !LED_CORE_FUSED
+/**
+ * @brief Pixels[i].<chan> = ChannelScaler(Colors[i].<chan>, scale of pixel i) for all active pixels.
+ *
+ * Runs plane by plane with LED_CORE_SOA, pixel by pixel otherwise.
+ */
+inline void ScaleColorsIntoPixels() {
+  auto &v = GetVars();
+  const size_t n = v.Count;
 
-  auto ApplyInterpolation = [](float t, InterpolationMode mode) {
-    t = constrain(t, 0.0f, 1.0f);
-    switch (mode) {
-      case InterpolationMode::Smooth:
-        return t * t * (3.0f - 2.0f * t);
-      case InterpolationMode::Linear:
-      default:
-        return t;
+#if LED_CORE_SOA
+#if LED_CORE_DITHER
+  Ditherer dither{v.ditherRounding};
+#endif
+  for (uint8_t channel = 0; channel < 4; ++channel) {
+    const ChannelScaler scaleChannel = MakeChannelScaler(channel);
+    const ColorSample *colors = v.Colors.Plane(channel);
+    const ScaleSample *scale = v.Scale.Window(channel);
+    uint8_t *pixels = v.Pixels.Plane(channel);
+#if LED_CORE_DITHER
+    uint8_t *error = v.DitherError[channel];
+    for (size_t i = 0; i < n; ++i) {
+      pixels[i] = dither(scaleChannel.Wide(colors[i], scale[i]), error[i]);
+    }
+#else
+    for (size_t i = 0; i < n; ++i) {
+      pixels[i] = scaleChannel(colors[i], scale[i]);
+    }
+#endif
+  }
+#if LED_CORE_DITHER
+  v.ditherPending = dither.fractions != 0;
+#endif
+#else
+  const ChannelScaler outR = MakeChannelScaler(0);
+  const ChannelScaler outG = MakeChannelScaler(1);
+  const ChannelScaler outB = MakeChannelScaler(2);
+  const ChannelScaler outW = MakeChannelScaler(3);
+  const ScaleSample *scaleR = v.Scale.Window(0);
+  const ScaleSample *scaleG = v.Scale.Window(1);
+  const ScaleSample *scaleB = v.Scale.Window(2);
+  const ScaleSample *scaleW = v.Scale.Window(3);
+#if LED_CORE_DITHER
+  Ditherer dither{v.ditherRounding};
+  for (size_t i = 0; i < n; ++i) {
+    StorePixel(v.Pixels, i,
+               dither(outR.Wide(v.Colors[i].R, scaleR[i]), v.DitherError[0][i]),
+               dither(outG.Wide(v.Colors[i].G, scaleG[i]), v.DitherError[1][i]),
+               dither(outB.Wide(v.Colors[i].B, scaleB[i]), v.DitherError[2][i]),
+               dither(outW.Wide(v.Colors[i].W, scaleW[i]), v.DitherError[3][i]));
+  }
+  v.ditherPending = dither.fractions != 0;
+#else
+  for (size_t i = 0; i < n; ++i) {
+    StorePixel(v.Pixels, i,
+               outR(v.Colors[i].R, scaleR[i]),
+               outG(v.Colors[i].G, scaleG[i]),
+               outB(v.Colors[i].B, scaleB[i]),
+               outW(v.Colors[i].W, scaleW[i]));
+  }
+#endif
+#endif
+}
+#endif
+
+
+/**
+ * @brief Append pixels [begin, end) to the table as `kind`, extending the last span when contiguous.
+ *
+ * Every GradientMode produces at most GradientTable::MaxSpans runs.
+ */
+inline void AddGradientSpan(GradientTable &table, size_t begin, size_t end, GradientSpanKind kind) {
+  if (end <= begin) return;
+
+  if (table.spanCount > 0) {
+    GradientSpan &last = table.Spans[table.spanCount - 1];
+    if (last.kind == kind && last.end == begin) {
+      last.end = end;
+      return;
+    }
+  }
+
+  if (table.spanCount >= GradientTable::MaxSpans) return;
+  table.Spans[table.spanCount++] = { begin, end, kind };
+}
+
+
+/**
+ * @brief Blend weight for a ramp position `t` in [0, 1], shaped by `Interp`.
+ */
+template<InterpolationMode Interp>
+inline float InterpolateWeight(float t) {
+  t = constrain(t, 0.0f, 1.0f);
+  if constexpr (Interp == InterpolationMode::Smooth) {
+    return t * t * (3.0f - 2.0f * t);
+  } else {
+    return t;
+  }
+}
+
+
+#if LED_CORE_FIXED_POINT
+//////// GRADIENT TABLE BUILDERS (integer pipeline) ////////
+// Same regions and weights as the float builders; the per-pixel weights are
+// stepped with Q40 accumulators and stored as Q24.
+
+/**
+ * @brief Store the weights of pixels [begin, end), ramping linearly (Q40) from `ramp` by `step` per pixel.
+ */
+template<InterpolationMode Interp>
+inline void AddGradientRamp(GradientTable &table, size_t begin, size_t end, GradientSpanKind kind, int64_t ramp, int64_t step) {
+  for (size_t i = begin; i < end; ++i, ramp += step) {
+    const int32_t weight = FIXED::WeightFromRamp(ramp);
+    if constexpr (Interp == InterpolationMode::Smooth) {
+      table.Weight[i] = FIXED::Smoothstep(weight);
+    } else {
+      table.Weight[i] = weight;
     }
+  }
+  AddGradientSpan(table, begin, end, kind);
+}
+
+/**
+ * @brief Store one constant weight for pixels [begin, end).
+ */
+inline void AddGradientConstant(GradientTable &table, size_t begin, size_t end, int32_t weight) {
+  for (size_t i = begin; i < end; ++i) table.Weight[i] = weight;
+  AddGradientSpan(table, begin, end, SPAN_BLEND);
+}
+
+inline void BuildLinearPaddingTable(GradientTable &table) {
+  const auto &c = GetConfig();
+  const size_t n = table.count;
+  const float padStart = constrain(c.gradientPaddingBegin, 0.0f, 0.4f);
+  const float padValue = constrain(c.gradientPaddingValue, 0.0f, 1.0f);
+
+  if (n == 0) return;
+
+  if (n == 1) {
+    AddGradientConstant(table, 0, 1, FIXED::kWeightOne / 2);
+    return;
+  }
+
+  const float startIdx = padStart * static_cast<float>(n - 1);
+  const float endIdx = (1.0f - padStart) * static_cast<float>(n - 1);
+  const float range = endIdx - startIdx;
+
+  // pixels <= startIdx keep the padded mix, pixels >= endIdx the mirrored one
+  const size_t rampBegin = FIXED::CountPositionsBelow(padStart, n, true);
+  size_t rampEnd = (range <= 0.0f) ? rampBegin : FIXED::CountPositionsBelow(1.0f - padStart, n, false);
+  if (rampEnd < rampBegin) rampEnd = rampBegin;
+
+  AddGradientConstant(table, 0, rampBegin, FIXED::WeightFromRamp(FIXED::RampFromFloat(1.0f - padValue)));
+
+  if (rampEnd > rampBegin) {
+    // w2(i) = (1 - padValue) - (1 - 2 * padValue) * (i - startIdx) / range
+    const float slope = (1.0f - 2.0f * padValue) / range;
+    const float first = (1.0f - padValue) - slope * (static_cast<float>(rampBegin) - startIdx);
+    AddGradientRamp<InterpolationMode::Linear>(table, rampBegin, rampEnd, SPAN_BLEND,
+                                               FIXED::RampFromFloat(first), FIXED::RampFromFloat(-slope));
+  }
+
+  AddGradientConstant(table, rampEnd, n, FIXED::WeightFromRamp(FIXED::RampFromFloat(padValue)));
+}
+
+template<InterpolationMode Interp>
+inline void BuildEdgeCenterTable(GradientTable &table) {
+  const auto &c = GetConfig();
+  const size_t n = table.count;
+  float edgeSize = constrain(c.gradientMiddleEdgeSize, 0.0f, 0.5f);
+  float centerSize = constrain(c.gradientMiddleCenterSize, 0.0f, 1.0f);
+  const float maxCenter = 1.0f - 2.0f * edgeSize;
+  if (centerSize > maxCenter) centerSize = maxCenter;
+  if (centerSize < 0.0f) centerSize = 0.0f;
+
+  float transitionTotal = 1.0f - (2.0f * edgeSize + centerSize);
+  if (transitionTotal < 0.0f) transitionTotal = 0.0f;
+  const float halfTransition = transitionTotal * 0.5f;
+
+  if (halfTransition <= 1e-6f || n <= 1) {
+    AddGradientSpan(table, 0, n, SPAN_PRIMARY);
+    return;
+  }
+
+  const float leftEdgeEnd = edgeSize;
+  const float leftTransitionEnd = leftEdgeEnd + halfTransition;
+  const float centerEnd = leftTransitionEnd + centerSize;
+  const float rightTransitionEnd = centerEnd + halfTransition;
+
+  // region boundaries as pixel indices (monotonic)
+  const size_t e1 = FIXED::CountPositionsBelow(leftEdgeEnd, n, true);
+  const size_t e2 = max(e1, FIXED::CountPositionsBelow(leftTransitionEnd, n, false));
+  const size_t e3 = max(e2, FIXED::CountPositionsBelow(centerEnd, n, false));
+  const size_t e4 = max(e3, FIXED::CountPositionsBelow(rightTransitionEnd, n, false));
+
+  const float invSpan = 1.0f / static_cast<float>(n - 1);
+  const int64_t step = FIXED::RampFromFloat(invSpan / halfTransition);
+
+  AddGradientSpan(table, 0, e1, SPAN_PRIMARY);
+  AddGradientRamp<Interp>(table, e1, e2, SPAN_BLEND,
+                          FIXED::RampFromFloat((static_cast<float>(e1) * invSpan - leftEdgeEnd) / halfTransition), step);
+  AddGradientSpan(table, e2, e3, SPAN_SECONDARY);
+  AddGradientRamp<Interp>(table, e3, e4, SPAN_BLEND_REVERSED,
+                          FIXED::RampFromFloat((static_cast<float>(e3) * invSpan - centerEnd) / halfTransition), step);
+  AddGradientSpan(table, e4, n, SPAN_PRIMARY);
+}
+
+inline void BuildLinearTable(GradientTable &table) {
+  const size_t n = table.count;
+  if (n <= 1) {
+    AddGradientSpan(table, 0, n, SPAN_PRIMARY);
+    return;
+  }
+
+  // t = i / (n - 1); the last pixel is clamped onto the secondary color
+  const int64_t step = (FIXED::kRampOne + static_cast<int64_t>(n - 2)) / static_cast<int64_t>(n - 1);
+  AddGradientRamp<InterpolationMode::Linear>(table, 0, n, SPAN_BLEND, 0, step);
+}
+
+#else
+//////// GRADIENT TABLE BUILDERS ////////
+// Every pixel lands in the same region with the same (clamped) weight as the
+// old per-pixel classification; the region boundaries are found first so the
+// weight loops themselves carry no branches.
+
+inline void BuildLinearPaddingTable(GradientTable &table) {
+  const auto &c = GetConfig();
+  const size_t n = table.count;
+  const float padStart = constrain(c.gradientPaddingBegin, 0.0f, 0.4f);
+  const float padValue = constrain(c.gradientPaddingValue, 0.0f, 1.0f);
+
+  if (n == 0) return;
+
+  if (n == 1) {
+    table.Weight[0] = 0.5f;
+    AddGradientSpan(table, 0, 1, SPAN_BLEND);
+    return;
+  }
+
+  const float startIdx = padStart * static_cast<float>(n - 1);
+  const float endIdx = (1.0f - padStart) * static_cast<float>(n - 1);
+  const float range = endIdx - startIdx;
+
+  // pixels <= startIdx keep the padded mix, pixels >= endIdx (or all, on an empty ramp) the mirrored one
+  size_t rampBegin = 0;
+  while (rampBegin < n && static_cast<float>(rampBegin) <= startIdx) ++rampBegin;
+  size_t rampEnd = rampBegin;
+  if (range > 0.0f) {
+    while (rampEnd < n && static_cast<float>(rampEnd) < endIdx) ++rampEnd;
+  }
+
+  const float padWeight = constrain(1.0f - padValue, 0.0f, 1.0f);
+  const float endWeight = constrain(1.0f - (1.0f - padValue), 0.0f, 1.0f);
+  const float slope = 1.0f - 2.0f * padValue;
+
+  for (size_t i = 0; i < rampBegin; ++i) table.Weight[i] = padWeight;
+  for (size_t i = rampBegin; i < rampEnd; ++i) {
+    const float t = (static_cast<float>(i) - startIdx) / range;
+    const float w1 = padValue + slope * constrain(t, 0.0f, 1.0f);
+    table.Weight[i] = constrain(1.0f - w1, 0.0f, 1.0f);
+  }
+  for (size_t i = rampEnd; i < n; ++i) table.Weight[i] = endWeight;
+
+  AddGradientSpan(table, 0, n, SPAN_BLEND);
+}
+
+template<InterpolationMode Interp>
+inline void BuildEdgeCenterTable(GradientTable &table) {
+  const auto &c = GetConfig();
+  const size_t n = table.count;
+  float edgeSize = constrain(c.gradientMiddleEdgeSize, 0.0f, 0.5f);
+  float centerSize = constrain(c.gradientMiddleCenterSize, 0.0f, 1.0f);
+  const float maxCenter = 1.0f - 2.0f * edgeSize;
+  if (centerSize > maxCenter) centerSize = maxCenter;
+  if (centerSize < 0.0f) centerSize = 0.0f;
+
+  float transitionTotal = 1.0f - (2.0f * edgeSize + centerSize);
+  if (transitionTotal < 0.0f) transitionTotal = 0.0f;
+  const float halfTransition = transitionTotal * 0.5f;
+
+  if (halfTransition <= 1e-6f || n <= 1) {
+    AddGradientSpan(table, 0, n, SPAN_PRIMARY);
+    return;
+  }
+
+  const float leftEdgeEnd = edgeSize;
+  const float leftTransitionEnd = leftEdgeEnd + halfTransition;
+  const float centerEnd = leftTransitionEnd + centerSize;
+  const float rightTransitionEnd = centerEnd + halfTransition;
+
+  auto position = [n](size_t i) { return static_cast<float>(i) / static_cast<float>(n - 1); };
+
+  // region boundaries as pixel indices (positions are monotonic)
+  size_t e1 = 0;
+  while (e1 < n && position(e1) <= leftEdgeEnd) ++e1;
+  size_t e2 = e1;
+  while (e2 < n && position(e2) < leftTransitionEnd) ++e2;
+  size_t e3 = e2;
+  while (e3 < n && position(e3) < centerEnd) ++e3;
+  size_t e4 = e3;
+  while (e4 < n && position(e4) < rightTransitionEnd) ++e4;
+
+  for (size_t i = e1; i < e2; ++i) {
+    table.Weight[i] = constrain(InterpolateWeight<Interp>((position(i) - leftEdgeEnd) / halfTransition), 0.0f, 1.0f);
+  }
+  for (size_t i = e3; i < e4; ++i) {
+    table.Weight[i] = constrain(InterpolateWeight<Interp>((position(i) - centerEnd) / halfTransition), 0.0f, 1.0f);
+  }
+
+  AddGradientSpan(table, 0, e1, SPAN_PRIMARY);
+  AddGradientSpan(table, e1, e2, SPAN_BLEND);
+  AddGradientSpan(table, e2, e3, SPAN_SECONDARY);
+  AddGradientSpan(table, e3, e4, SPAN_BLEND_REVERSED);
+  AddGradientSpan(table, e4, n, SPAN_PRIMARY);
+}
+
+inline void BuildLinearTable(GradientTable &table) {
+  const size_t n = table.count;
+  if (n <= 1) {
+    AddGradientSpan(table, 0, n, SPAN_PRIMARY);
+    return;
+  }
+
+  for (size_t i = 0; i < n; ++i) {
+    table.Weight[i] = static_cast<float>(i) / static_cast<float>(n - 1);
+  }
+  AddGradientSpan(table, 0, n, SPAN_BLEND);
+}
+#endif
+
+
+/**
+ * @brief Fill the gradient table for one GradientMode / InterpolationMode pair.
+ *
+ * One instantiation per combination; GradientTableBuilder() picks it once per
+ * rebuild, so the builders never re-test the mode or interpolation per pixel.
+ */
+template<GradientMode Mode, InterpolationMode Interp>
+inline void BuildGradientTable(GradientTable &table) {
+  const size_t n = table.count;
+
+  if constexpr (Mode == SINGLE_COLOR) {
+    AddGradientSpan(table, 0, n, SPAN_PRIMARY);
+  } else if constexpr (Mode == MIDPOINT_SPLIT) {
+    const size_t splitIndex = (n + 1) / 2;
+    AddGradientSpan(table, 0, splitIndex, SPAN_PRIMARY);
+    AddGradientSpan(table, splitIndex, n, SPAN_SECONDARY);
+  } else if constexpr (Mode == LINEAR_PADDING) {
+    BuildLinearPaddingTable(table);
+  } else if constexpr (Mode == EDGE_CENTER) {
+    BuildEdgeCenterTable<Interp>(table);
+  } else {
+    BuildLinearTable(table);
+  }
+}
+
+using GradientTableBuildFn = void (*)(GradientTable &);
+
+/**
+ * @brief Builder for `mode` / `interp`; unknown modes fall back to LINEAR.
+ */
+inline GradientTableBuildFn GradientTableBuilder(GradientMode mode, InterpolationMode interp) {
+  static constexpr GradientTableBuildFn kBuilders[5][2] = {
+    { &BuildGradientTable<LINEAR, InterpolationMode::Linear>, &BuildGradientTable<LINEAR, InterpolationMode::Smooth> },
+    { &BuildGradientTable<LINEAR_PADDING, InterpolationMode::Linear>, &BuildGradientTable<LINEAR_PADDING, InterpolationMode::Smooth> },
+    { &BuildGradientTable<SINGLE_COLOR, InterpolationMode::Linear>, &BuildGradientTable<SINGLE_COLOR, InterpolationMode::Smooth> },
+    { &BuildGradientTable<MIDPOINT_SPLIT, InterpolationMode::Linear>, &BuildGradientTable<MIDPOINT_SPLIT, InterpolationMode::Smooth> },
+    { &BuildGradientTable<EDGE_CENTER, InterpolationMode::Linear>, &BuildGradientTable<EDGE_CENTER, InterpolationMode::Smooth> },
   };
 
+  const size_t row = (static_cast<int>(mode) >= 0 && static_cast<int>(mode) <= EDGE_CENTER) ? static_cast<size_t>(mode) : 0;
+  const size_t column = (interp == InterpolationMode::Smooth) ? 1 : 0;
+  return kBuilders[row][column];
+}
+
+
+/**
+ * @brief Return the gradient table for `mode`, rebuilding it if Count, the mode
+ *        or any gradient* Config field changed since the last build.
+ */
+inline const GradientTable &UpdateGradientTable(GradientMode mode) {
+  auto &v = GetVars();
+  const auto &c = GetConfig();
+  GradientTable &table = v.Gradient;
+
+  const bool current = table.valid
+                       && table.count == v.Count
+                       && table.mode == mode
+                       && table.paddingBegin == c.gradientPaddingBegin
+                       && table.paddingValue == c.gradientPaddingValue
+                       && table.middleEdgeSize == c.gradientMiddleEdgeSize
+                       && table.middleCenterSize == c.gradientMiddleCenterSize
+                       && table.interpolationMode == c.gradientInterpolationMode;
+  if (current) return table;
+
+  table.valid = true;
+  table.count = v.Count;
+  table.mode = mode;
+  table.paddingBegin = c.gradientPaddingBegin;
+  table.paddingValue = c.gradientPaddingValue;
+  table.middleEdgeSize = c.gradientMiddleEdgeSize;
+  table.middleCenterSize = c.gradientMiddleCenterSize;
+  table.interpolationMode = c.gradientInterpolationMode;
+  table.spanCount = 0;
+
+  GradientTableBuilder(mode, c.gradientInterpolationMode)(table);
+  return table;
+}
+
+
+/**
+ * @brief Evaluate the gradient for every active pixel and hand it to `emit`.
+ *
+ * The position-dependent weights come from the cached GradientTable, so a
+ * frame is a solid fill or a plain a + (b - a) * Weight[i] blend per pixel.
+ *
+ * `emit(index, r, g, b, w)` receives the gradient color of each pixel as
+ * ColorSample exactly once; ComputeGradient() stores it in Colors[], RenderFrame() with
+ * LED_CORE_FUSED scales it straight into Pixels[].
+ */
+template<typename Sink>
+inline void RenderGradient(GradientMode mode, bool invertColors, Sink &&emit) {
+  auto &v = GetVars();
+
+  if (v.Count == 0) return;
+
+  const GradientTable &table = UpdateGradientTable(mode);
+
+#if LED_CORE_FIXED_POINT
+  const FIXED::Pixel_q16 primaryColor = FIXED::ColorFromPixel(invertColors ? v.colorTwo : v.colorOne);
+  const FIXED::Pixel_q16 secondaryColor = FIXED::ColorFromPixel(invertColors ? v.colorOne : v.colorTwo);
 
+  auto fillSpan = [&](const GradientSpan &span, const FIXED::Pixel_q16 &src) {
+    const ColorSample r = FIXED::ToColorSample(src.R);
+    const ColorSample g = FIXED::ToColorSample(src.G);
+    const ColorSample b = FIXED::ToColorSample(src.B);
+    const ColorSample w = FIXED::ToColorSample(src.W);
+    for (size_t i = span.begin; i < span.end; ++i) {
+      emit(i, r, g, b, w);
+    }
+  };
+
+  auto blendSpan = [&](const GradientSpan &span, const FIXED::Pixel_q16 &a, const FIXED::Pixel_q16 &b) {
+    for (size_t i = span.begin; i < span.end; ++i) {
+      const int32_t weight = table.Weight[i];
+      emit(i,
+           FIXED::Blend(a.R, b.R, weight),
+           FIXED::Blend(a.G, b.G, weight),
+           FIXED::Blend(a.B, b.B, weight),
+           FIXED::Blend(a.W, b.W, weight));
+    }
+  };
+#else
   const Pixel_float &primaryColor = invertColors ? v.colorTwo : v.colorOne;
   const Pixel_float &secondaryColor = invertColors ? v.colorOne : v.colorTwo;
 
-  auto applyColor = [&](size_t index, const Pixel_float &src) {
-    v.Colors[index].R = static_cast<uint8_t>(src.R);
-    v.Colors[index].G = static_cast<uint8_t>(src.G);
-    v.Colors[index].B = static_cast<uint8_t>(src.B);
-    v.Colors[index].W = static_cast<uint8_t>(src.W);
+  auto fillSpan = [&](const GradientSpan &span, const Pixel_float &src) {
+    const ColorSample r = ToColorSample(src.R);
+    const ColorSample g = ToColorSample(src.G);
+    const ColorSample b = ToColorSample(src.B);
+    const ColorSample w = ToColorSample(src.W);
+    for (size_t i = span.begin; i < span.end; ++i) {
+      emit(i, r, g, b, w);
+    }
   };
 
-  auto blendColors = [&](const Pixel_float &a, const Pixel_float &b, float t) {
-    t = constrain(t, 0.0f, 1.0f);
-    Pixel_float result;
-    result.R = a.R + (b.R - a.R) * t;
-    result.G = a.G + (b.G - a.G) * t;
-    result.B = a.B + (b.B - a.B) * t;
-    result.W = a.W + (b.W - a.W) * t;
-    return result;
+  auto blendSpan = [&](const GradientSpan &span, const Pixel_float &a, const Pixel_float &b) {
+    for (size_t i = span.begin; i < span.end; ++i) {
+      const float t = table.Weight[i];
+      emit(i,
+           ToColorSample(a.R + (b.R - a.R) * t),
+           ToColorSample(a.G + (b.G - a.G) * t),
+           ToColorSample(a.B + (b.B - a.B) * t),
+           ToColorSample(a.W + (b.W - a.W) * t));
+    }
   };
+#endif
 
-  switch (mode) {
-    case SINGLE_COLOR:
-      {
-        for (size_t i = 0; i < v.Count; ++i) {
-          applyColor(i, primaryColor);
-        }
+  for (uint8_t s = 0; s < table.spanCount; ++s) {
+    const GradientSpan &span = table.Spans[s];
+    switch (span.kind) {
+      case SPAN_PRIMARY:
+        fillSpan(span, primaryColor);
         break;
-      }
-
-    case MIDPOINT_SPLIT:
-      {
-        const size_t splitIndex = (v.Count + 1) / 2;
-        for (size_t i = 0; i < v.Count; ++i) {
-          const auto &src = (i < splitIndex) ? primaryColor : secondaryColor;
-          applyColor(i, src);
-        }
+      case SPAN_SECONDARY:
+        fillSpan(span, secondaryColor);
         break;
-      }
-
-    case LINEAR_PADDING:
-      {
-        const auto &c = GetConfig();
-        const float padStart = constrain(c.gradientPaddingBegin, 0.0f, 0.4f);
-        const float padValue = constrain(c.gradientPaddingValue, 0.0f, 1.0f);
-
-        const size_t n = v.Count;
-        if (n == 0) {
-          break;
-        }
-
-        if (n == 1) {
-          const float w2 = 0.5f;
-          Pixel_float blended = blendColors(primaryColor, secondaryColor, w2);
-          applyColor(0, blended);
-          break;
-        }
-
-        const float startIdx = padStart * static_cast<float>(n - 1);
-        const float endIdx = (1.0f - padStart) * static_cast<float>(n - 1);
-        const float range = endIdx - startIdx;
-
-        for (size_t i = 0; i < n; ++i) {
-          float w1;
-          if (static_cast<float>(i) <= startIdx) {
-            w1 = padValue;
-          } else if (static_cast<float>(i) >= endIdx || range <= 0.0f) {
-            w1 = 1.0f - padValue;
-          } else {
-            const float t = (static_cast<float>(i) - startIdx) / range;
-            w1 = padValue + (1.0f - 2.0f * padValue) * constrain(t, 0.0f, 1.0f);
-          }
-
-          float w2 = 1.0f - w1;
-          w1 = constrain(w1, 0.0f, 1.0f);
-          w2 = constrain(w2, 0.0f, 1.0f);
-
-          Pixel_float blended = blendColors(primaryColor, secondaryColor, w2);
-          applyColor(i, blended);
-        }
+      case SPAN_BLEND:
+        blendSpan(span, primaryColor, secondaryColor);
         break;
-      }
-
-    case EDGE_CENTER:
-      {
-        const auto &c = GetConfig();
-        float edgeSize = constrain(c.gradientMiddleEdgeSize, 0.0f, 0.5f);
-        float centerSize = constrain(c.gradientMiddleCenterSize, 0.0f, 1.0f);
-        const float maxCenter = 1.0f - 2.0f * edgeSize;
-        if (centerSize > maxCenter) centerSize = maxCenter;
-        if (centerSize < 0.0f) centerSize = 0.0f;
-
-        float transitionTotal = 1.0f - (2.0f * edgeSize + centerSize);
-        if (transitionTotal < 0.0f) transitionTotal = 0.0f;
-        const float halfTransition = transitionTotal * 0.5f;
-
-        const float leftEdgeEnd = edgeSize;
-        const float leftTransitionEnd = leftEdgeEnd + halfTransition;
-        const float centerEnd = leftTransitionEnd + centerSize;
-        const float rightTransitionEnd = centerEnd + halfTransition;
-
-        const size_t n = v.Count;
-        for (size_t i = 0; i < n; ++i) {
-          float x = (n <= 1) ? 0.0f : static_cast<float>(i) / static_cast<float>(n - 1);
-
-          if (x <= leftEdgeEnd || halfTransition <= 1e-6f) {
-            applyColor(i, primaryColor);
-            continue;
-          }
-
-          if (x < leftTransitionEnd && halfTransition > 1e-6f) {
-            float t = (x - leftEdgeEnd) / halfTransition;
-            float blend = ApplyInterpolation(t, c.gradientInterpolationMode);
-            Pixel_float blended = blendColors(primaryColor, secondaryColor, blend);
-            applyColor(i, blended);
-            continue;
-          }
-
-          if (x < centerEnd) {
-            applyColor(i, secondaryColor);
-            continue;
-          }
-
-          if (x < rightTransitionEnd && halfTransition > 1e-6f) {
-            float t = (x - centerEnd) / halfTransition;
-            float blend = ApplyInterpolation(t, c.gradientInterpolationMode);
-            Pixel_float blended = blendColors(secondaryColor, primaryColor, blend);
-            applyColor(i, blended);
-            continue;
-          }
-
-          applyColor(i, primaryColor);
-        }
+      case SPAN_BLEND_REVERSED:
+        blendSpan(span, secondaryColor, primaryColor);
         break;
-      }
-
-    case LINEAR:
-    default:
-      {
-        if (v.Count <= 1) {
-          for (size_t i = 0; i < v.Count; ++i) {
-            applyColor(i, primaryColor);
-          }
-          break;
-        }
-
-        for (size_t i = 0; i < v.Count; ++i) {
-          const float t = static_cast<float>(i) / static_cast<float>(v.Count - 1);
-
-          Pixel_float blended = blendColors(primaryColor, secondaryColor, t);
-          applyColor(i, blended);
-        }
-        break;
-      }
+    }
   }
 }
 
 
 
 
+#if !LED_CORE_FUSED
+/**
+ * @brief Compute the gradient into Colors[].
+ */
+inline void ComputeGradient(GradientMode mode, bool invertColors) {
+  auto &v = GetVars();
+
+  RenderGradient(mode, invertColors, [&v](size_t i, ColorSample r, ColorSample g, ColorSample b, ColorSample w) {
+    v.Colors[i].R = r;
+    v.Colors[i].G = g;
+    v.Colors[i].B = b;
+    v.Colors[i].W = w;
+  });
+}
+
+
 /**
  * @brief Apply per-pixel scaling and global intensity factors to Colors[] and write result into Pixels[].
  *
  * For each pixel i:
- *   Pixels[i].<chan> = round( Colors[i].<chan> * Scale[i].<chan> * (Brightness / 255.0f) * OnOffFactor )
+ *   Pixels[i].<chan> = round( Colors[i].<chan> * Scale.Window(<chan>)[i] * (Brightness / 255.0f) * OnOffFactor )
  *
- * Float math is used for scale. Result is clamped to [0,255].
+ * Float math is used for scale (integer math with LED_CORE_FIXED_POINT). Result is clamped to [0,255].
  */
 inline void ApplyOutputScaling() {
-  auto &v = GetVars();
-
-  const float brightnessNorm = constrain(v.brightness, 0.0f, 255.0f) / 255.0f;
-  const float onOff = v.onoffFactor;
-
-  const size_t n = v.Count;
-  for (size_t i = 0; i < n; ++i) {
-    const float scaledR = static_cast<float>(v.Colors[i].R) * v.Scale[i].R;
-    const float scaledG = static_cast<float>(v.Colors[i].G) * v.Scale[i].G;
-    const float scaledB = static_cast<float>(v.Colors[i].B) * v.Scale[i].B;
-    const float scaledW = static_cast<float>(v.Colors[i].W) * v.Scale[i].W;
-
-    const float baseR = constrain(scaledR, 0.0f, 255.0f);
-    const float baseG = constrain(scaledG, 0.0f, 255.0f);
-    const float baseB = constrain(scaledB, 0.0f, 255.0f);
-    const float baseW = constrain(scaledW, 0.0f, 255.0f);
-
-    const float finalR = baseR * brightnessNorm * onOff;
-    const float finalG = baseG * brightnessNorm * onOff;
-    const float finalB = baseB * brightnessNorm * onOff;
-    const float finalW = baseW * brightnessNorm * onOff;
+  ScaleColorsIntoPixels();
+}
+#endif
 
-    int ri = static_cast<int>(finalR + 0.5f);
-    int gi = static_cast<int>(finalG + 0.5f);
-    int bi = static_cast<int>(finalB + 0.5f);
-    int wi = static_cast<int>(finalW + 0.5f);
 
-    SetPixelRGBW(i, ri, gi, bi, wi);
-  }
+/**
+ * @brief Render one frame of the gradient into Pixels[].
+ *
+ * Without LED_CORE_FUSED this is ComputeGradient() followed by ApplyOutputScaling().
+ * With it, each gradient color is scaled and written to Pixels[] as soon as it
+ * is computed, so the strip is walked once and Colors[] is never touched.
+ * Both produce the same Pixels[].
+ */
+inline void RenderFrame(GradientMode mode, bool invertColors) {
+#if LED_CORE_FUSED
+  auto &v = GetVars();
+  const ChannelScaler outR = MakeChannelScaler(0);
+  const ChannelScaler outG = MakeChannelScaler(1);
+  const ChannelScaler outB = MakeChannelScaler(2);
+  const ChannelScaler outW = MakeChannelScaler(3);
+  const ScaleSample *scaleR = v.Scale.Window(0);
+  const ScaleSample *scaleG = v.Scale.Window(1);
+  const ScaleSample *scaleB = v.Scale.Window(2);
+  const ScaleSample *scaleW = v.Scale.Window(3);
+
+#if LED_CORE_DITHER
+  Ditherer dither{v.ditherRounding};
+  RenderGradient(mode, invertColors, [&](size_t i, ColorSample r, ColorSample g, ColorSample b, ColorSample w) {
+    StorePixel(v.Pixels, i,
+               dither(outR.Wide(r, scaleR[i]), v.DitherError[0][i]),
+               dither(outG.Wide(g, scaleG[i]), v.DitherError[1][i]),
+               dither(outB.Wide(b, scaleB[i]), v.DitherError[2][i]),
+               dither(outW.Wide(w, scaleW[i]), v.DitherError[3][i]));
+  });
+  v.ditherPending = dither.fractions != 0;
+#else
+  RenderGradient(mode, invertColors, [&](size_t i, ColorSample r, ColorSample g, ColorSample b, ColorSample w) {
+    StorePixel(v.Pixels, i,
+               outR(r, scaleR[i]),
+               outG(g, scaleG[i]),
+               outB(b, scaleB[i]),
+               outW(w, scaleW[i]));
+  });
+#endif
+#else
+  ComputeGradient(mode, invertColors);
+  ApplyOutputScaling();
+#endif
 }
 
 
@@ -699,6 +1804,36 @@ inline void MarkChangeInConfig() {
 
   ++cfg.changeCounter;
   cfg.lastModifiedMs = millis();
+
+  MarkRenderDirty();
+}
+
+
+/**
+ * @brief Request a new frame on the next LED::Update() (fade, effect or config changed)
+ * @param NONE
+ * @return NONE
+ */
+inline void MarkRenderDirty() {
+  GetState().renderDirty = true;
+  Wake();
+}
+
+
+/**
+ * @brief Leave the quiescent state so LED::Update() fades, steps and renders again.
+ *
+ * The update timers restart at the wake-up time, so the first fade after a
+ * long idle period integrates one interval instead of the whole idle time.
+ */
+inline void Wake() {
+  State &s = GetState();
+  if (!s.idle) return;
+
+  s.idle = false;
+  const uint32_t now = millis();
+  s.processingLastExecutionMs = now;
+  s.effectLastExecutionMs = now;
 }
 
 
@@ -733,37 +1868,12 @@ inline void ShiftScaleChannel(float newValue, int8_t channel, bool forward) {
   }
 
 
-  float Pixel_float::*channelPtr = &Pixel_float::R;
-  switch (channel) {
-    case 0:
-      channelPtr = &Pixel_float::R;
-      break;
-    case 1:
-      channelPtr = &Pixel_float::G;
-      break;
-    case 2:
-      channelPtr = &Pixel_float::B;
-      break;
-    case 3:
-      channelPtr = &Pixel_float::W;
-      break;
-    default:
-      break;
-  }
+  // the rings are laid out for v.Count pixels; restart them if Count changed without Init()
+  if (v.Scale.Length != v.Count) v.Scale.Reset(v.Count, ToScaleSample(1.0f));
 
-  const size_t lastIndex = v.Count - 1;
-
-  if (forward) {
-    for (size_t i = lastIndex; i > 0; --i) {
-      v.Scale[i].*channelPtr = v.Scale[i - 1].*channelPtr;
-    }
-    v.Scale[0].*channelPtr = newValue;
-  } else {
-    for (size_t i = 0; i < lastIndex; ++i) {
-      v.Scale[i].*channelPtr = v.Scale[i + 1].*channelPtr;
-    }
-    v.Scale[lastIndex].*channelPtr = newValue;
-  }
+  const ScaleSample sample = ToScaleSample(newValue);
+  const bool changed = forward ? v.Scale.PushFront(channel, sample) : v.Scale.PushBack(channel, sample);
+  if (changed) MarkRenderDirty();
 }
 
 
@@ -784,28 +1894,34 @@ inline void ShiftScaleChannel(float newValue, int8_t channel, bool forward) {
  */
 inline void Clear() {
   Vars &v = GetVars();
+  MarkRenderDirty();
   for (size_t i = 0; i < v.Count; ++i) {
+#if LED_CORE_FUSED
+    v.Pixels[i].R = 0;
+    v.Pixels[i].G = 0;
+    v.Pixels[i].B = 0;
+    v.Pixels[i].W = 0;
+#else
     v.Colors[i].R = 0;
     v.Colors[i].G = 0;
     v.Colors[i].B = 0;
     v.Colors[i].W = 0;
+#endif
   }
 }
 
+/**
+ * @brief Cubic curve 0..100 -> 0..255 (rounded), generated at compile time.
+ */
+inline constexpr GAMMA::CurveLut<uint8_t, 101> kCubic100to255 = GAMMA::MakeCurve<uint8_t, 101>(3.0, 255);
+
 /**
  * Map cubic 0..100 -> 0..255 (rounded)
  */
 inline int MapCubic100to255(int x) {
-  constexpr int inputMin = 0;
-  constexpr int inputMax = 100;
-  constexpr int outputMax = 255;
-
-  if (x <= inputMin) return 0;
-  if (x >= inputMax) return outputMax;
-
-  const float normalized = static_cast<float>(x) / static_cast<float>(inputMax);
-  const float scaled = normalized * normalized * normalized;
-  return static_cast<int>(scaled * outputMax + 0.5f);
+  if (x <= 0) return 0;
+  if (x >= 100) return 255;
+  return kCubic100to255[x];
 }
 
 }  // namespace CORE
@@ -3,139 +3,164 @@
 //////////////////////////////////
 #pragma once
 
-
-// Gamma brightness lookup table <https://victornpb.github.io/gamma-table-generator>
-// gamma = 1.60 steps = 256 range = 0-255
-const uint8_t gammaLut8_160[256] = {
-     0,   0,   0,   0,   0,   0,   1,   1,   1,   1,   1,   2,   2,   2,   2,   3,
-     3,   3,   4,   4,   4,   5,   5,   5,   6,   6,   7,   7,   7,   8,   8,   9,
-     9,  10,  10,  11,  11,  12,  12,  13,  13,  14,  14,  15,  15,  16,  16,  17,
-    18,  18,  19,  19,  20,  21,  21,  22,  23,  23,  24,  25,  25,  26,  27,  27,
-    28,  29,  29,  30,  31,  31,  32,  33,  34,  34,  35,  36,  37,  38,  38,  39,
-    40,  41,  42,  42,  43,  44,  45,  46,  46,  47,  48,  49,  50,  51,  52,  53,
-    53,  54,  55,  56,  57,  58,  59,  60,  61,  62,  63,  64,  64,  65,  66,  67,
-    68,  69,  70,  71,  72,  73,  74,  75,  76,  77,  78,  79,  80,  81,  83,  84,
-    85,  86,  87,  88,  89,  90,  91,  92,  93,  94,  95,  97,  98,  99, 100, 101,
-   102, 103, 104, 106, 107, 108, 109, 110, 111, 113, 114, 115, 116, 117, 119, 120,
-   121, 122, 123, 125, 126, 127, 128, 130, 131, 132, 133, 135, 136, 137, 138, 140,
-   141, 142, 143, 145, 146, 147, 149, 150, 151, 153, 154, 155, 157, 158, 159, 161,
-   162, 163, 165, 166, 167, 169, 170, 171, 173, 174, 176, 177, 178, 180, 181, 183,
-   184, 185, 187, 188, 190, 191, 193, 194, 196, 197, 198, 200, 201, 203, 204, 206,
-   207, 209, 210, 212, 213, 215, 216, 218, 219, 221, 222, 224, 225, 227, 228, 230,
-   231, 233, 235, 236, 238, 239, 241, 242, 244, 245, 247, 249, 250, 252, 253, 255,
-  };
-
-
-
-// Gamma brightness lookup table <https://victornpb.github.io/gamma-table-generator>
-// gamma = 1.80 steps = 256 range = 0-255
-const uint8_t gammaLut8_180[256] = {
-     0,   0,   0,   0,   0,   0,   0,   0,   1,   1,   1,   1,   1,   1,   1,   2,
-     2,   2,   2,   2,   3,   3,   3,   3,   4,   4,   4,   4,   5,   5,   5,   6,
-     6,   6,   7,   7,   8,   8,   8,   9,   9,  10,  10,  10,  11,  11,  12,  12,
-    13,  13,  14,  14,  15,  15,  16,  16,  17,  17,  18,  18,  19,  19,  20,  21,
-    21,  22,  22,  23,  24,  24,  25,  26,  26,  27,  28,  28,  29,  30,  30,  31,
-    32,  32,  33,  34,  35,  35,  36,  37,  38,  38,  39,  40,  41,  41,  42,  43,
-    44,  45,  46,  46,  47,  48,  49,  50,  51,  52,  53,  53,  54,  55,  56,  57,
-    58,  59,  60,  61,  62,  63,  64,  65,  66,  67,  68,  69,  70,  71,  72,  73,
-    74,  75,  76,  77,  78,  79,  80,  81,  82,  83,  84,  86,  87,  88,  89,  90,
-    91,  92,  93,  95,  96,  97,  98,  99, 100, 102, 103, 104, 105, 107, 108, 109,
-   110, 111, 113, 114, 115, 116, 118, 119, 120, 122, 123, 124, 126, 127, 128, 129,
-   131, 132, 134, 135, 136, 138, 139, 140, 142, 143, 145, 146, 147, 149, 150, 152,
-   153, 154, 156, 157, 159, 160, 162, 163, 165, 166, 168, 169, 171, 172, 174, 175,
-   177, 178, 180, 181, 183, 184, 186, 188, 189, 191, 192, 194, 195, 197, 199, 200,
-   202, 204, 205, 207, 208, 210, 212, 213, 215, 217, 218, 220, 222, 224, 225, 227,
-   229, 230, 232, 234, 236, 237, 239, 241, 243, 244, 246, 248, 250, 251, 253, 255,
-  };
-
-
-
-// Gamma brightness lookup table <https://victornpb.github.io/gamma-table-generator>
-// gamma = 2.00 steps = 256 range = 0-255
-const uint8_t gammaLut8_200[256] = {
-     0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   1,   1,   1,   1,
-     1,   1,   1,   1,   2,   2,   2,   2,   2,   2,   3,   3,   3,   3,   4,   4,
-     4,   4,   5,   5,   5,   5,   6,   6,   6,   7,   7,   7,   8,   8,   8,   9,
-     9,   9,  10,  10,  11,  11,  11,  12,  12,  13,  13,  14,  14,  15,  15,  16,
-    16,  17,  17,  18,  18,  19,  19,  20,  20,  21,  21,  22,  23,  23,  24,  24,
-    25,  26,  26,  27,  28,  28,  29,  30,  30,  31,  32,  32,  33,  34,  35,  35,
-    36,  37,  38,  38,  39,  40,  41,  42,  42,  43,  44,  45,  46,  47,  47,  48,
-    49,  50,  51,  52,  53,  54,  55,  56,  56,  57,  58,  59,  60,  61,  62,  63,
-    64,  65,  66,  67,  68,  69,  70,  71,  73,  74,  75,  76,  77,  78,  79,  80,
-    81,  82,  84,  85,  86,  87,  88,  89,  91,  92,  93,  94,  95,  97,  98,  99,
-   100, 102, 103, 104, 105, 107, 108, 109, 111, 112, 113, 115, 116, 117, 119, 120,
-   121, 123, 124, 126, 127, 128, 130, 131, 133, 134, 136, 137, 139, 140, 142, 143,
-   145, 146, 148, 149, 151, 152, 154, 155, 157, 158, 160, 162, 163, 165, 166, 168,
-   170, 171, 173, 175, 176, 178, 180, 181, 183, 185, 186, 188, 190, 192, 193, 195,
-   197, 199, 200, 202, 204, 206, 207, 209, 211, 213, 215, 217, 218, 220, 222, 224,
-   226, 228, 230, 232, 233, 235, 237, 239, 241, 243, 245, 247, 249, 251, 253, 255,
-  };
-
-
-
-// Gamma brightness lookup table <https://victornpb.github.io/gamma-table-generator>
-// gamma = 2.20 steps = 256 range = 0-255
-const uint8_t gammaLut8_220[256] = {
-     0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   1,
-     1,   1,   1,   1,   1,   1,   1,   1,   1,   2,   2,   2,   2,   2,   2,   2,
-     3,   3,   3,   3,   3,   4,   4,   4,   4,   5,   5,   5,   5,   6,   6,   6,
-     6,   7,   7,   7,   8,   8,   8,   9,   9,   9,  10,  10,  11,  11,  11,  12,
-    12,  13,  13,  13,  14,  14,  15,  15,  16,  16,  17,  17,  18,  18,  19,  19,
-    20,  20,  21,  22,  22,  23,  23,  24,  25,  25,  26,  26,  27,  28,  28,  29,
-    30,  30,  31,  32,  33,  33,  34,  35,  35,  36,  37,  38,  39,  39,  40,  41,
-    42,  43,  43,  44,  45,  46,  47,  48,  49,  49,  50,  51,  52,  53,  54,  55,
-    56,  57,  58,  59,  60,  61,  62,  63,  64,  65,  66,  67,  68,  69,  70,  71,
-    73,  74,  75,  76,  77,  78,  79,  81,  82,  83,  84,  85,  87,  88,  89,  90,
-    91,  93,  94,  95,  97,  98,  99, 100, 102, 103, 105, 106, 107, 109, 110, 111,
-   113, 114, 116, 117, 119, 120, 121, 123, 124, 126, 127, 129, 130, 132, 133, 135,
-   137, 138, 140, 141, 143, 145, 146, 148, 149, 151, 153, 154, 156, 158, 159, 161,
-   163, 165, 166, 168, 170, 172, 173, 175, 177, 179, 181, 182, 184, 186, 188, 190,
-   192, 194, 196, 197, 199, 201, 203, 205, 207, 209, 211, 213, 215, 217, 219, 221,
-   223, 225, 227, 229, 231, 234, 236, 238, 240, 242, 244, 246, 248, 251, 253, 255,
-  };
-
-
-
-// Gamma brightness lookup table <https://victornpb.github.io/gamma-table-generator>
-// gamma = 2.40 steps = 256 range = 0-255
-const uint8_t gammaLut8_240[256] = {
-     0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,
-     0,   0,   0,   1,   1,   1,   1,   1,   1,   1,   1,   1,   1,   1,   1,   2,
-     2,   2,   2,   2,   2,   2,   3,   3,   3,   3,   3,   4,   4,   4,   4,   4,
-     5,   5,   5,   5,   6,   6,   6,   6,   7,   7,   7,   8,   8,   8,   9,   9,
-     9,  10,  10,  10,  11,  11,  11,  12,  12,  13,  13,  14,  14,  14,  15,  15,
-    16,  16,  17,  17,  18,  18,  19,  19,  20,  20,  21,  22,  22,  23,  23,  24,
-    24,  25,  26,  26,  27,  28,  28,  29,  30,  30,  31,  32,  32,  33,  34,  35,
-    35,  36,  37,  38,  39,  39,  40,  41,  42,  43,  43,  44,  45,  46,  47,  48,
-    49,  50,  51,  52,  53,  53,  54,  55,  56,  57,  58,  59,  60,  62,  63,  64,
-    65,  66,  67,  68,  69,  70,  71,  73,  74,  75,  76,  77,  78,  80,  81,  82,
-    83,  85,  86,  87,  88,  90,  91,  92,  94,  95,  96,  98,  99, 100, 102, 103,
-   105, 106, 108, 109, 111, 112, 114, 115, 117, 118, 120, 121, 123, 124, 126, 127,
-   129, 131, 132, 134, 136, 137, 139, 141, 142, 144, 146, 148, 149, 151, 153, 155,
-   156, 158, 160, 162, 164, 166, 167, 169, 171, 173, 175, 177, 179, 181, 183, 185,
-   187, 189, 191, 193, 195, 197, 199, 201, 203, 205, 207, 210, 212, 214, 216, 218,
-   220, 223, 225, 227, 229, 232, 234, 236, 239, 241, 243, 246, 248, 250, 253, 255,
-  };
-
-
-
-// Gamma brightness lookup table <https://victornpb.github.io/gamma-table-generator>
-// gamma = 2.60 steps = 256 range = 0-255
-const uint8_t gammaLut8_260[256] = {
-     0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,
-     0,   0,   0,   0,   0,   0,   0,   0,   1,   1,   1,   1,   1,   1,   1,   1,
-     1,   1,   1,   1,   2,   2,   2,   2,   2,   2,   2,   2,   3,   3,   3,   3,
-     3,   3,   4,   4,   4,   4,   5,   5,   5,   5,   5,   6,   6,   6,   6,   7,
-     7,   7,   8,   8,   8,   9,   9,   9,  10,  10,  10,  11,  11,  11,  12,  12,
-    13,  13,  13,  14,  14,  15,  15,  16,  16,  17,  17,  18,  18,  19,  19,  20,
-    20,  21,  21,  22,  22,  23,  24,  24,  25,  25,  26,  27,  27,  28,  29,  29,
-    30,  31,  31,  32,  33,  34,  34,  35,  36,  37,  38,  38,  39,  40,  41,  42,
-    42,  43,  44,  45,  46,  47,  48,  49,  50,  51,  52,  53,  54,  55,  56,  57,
-    58,  59,  60,  61,  62,  63,  64,  65,  66,  68,  69,  70,  71,  72,  73,  75,
-    76,  77,  78,  80,  81,  82,  84,  85,  86,  88,  89,  90,  92,  93,  94,  96,
-    97,  99, 100, 102, 103, 105, 106, 108, 109, 111, 112, 114, 115, 117, 119, 120,
-   122, 124, 125, 127, 129, 130, 132, 134, 136, 137, 139, 141, 143, 145, 146, 148,
-   150, 152, 154, 156, 158, 160, 162, 164, 166, 168, 170, 172, 174, 176, 178, 180,
-   182, 184, 186, 188, 191, 193, 195, 197, 199, 202, 204, 206, 209, 211, 213, 215,
-   218, 220, 223, 225, 227, 230, 232, 235, 237, 240, 242, 245, 247, 250, 252, 255,
-  };
\ No newline at end of file
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * @file 220_GAMMA_TABLES.h
+ * @brief Compile-time generator for gamma and other power-curve lookup tables.
+ *
+ * Tables are computed by constexpr functions, so a new exponent (per fixture
+ * batch, or per channel for the white LEDs) is one line and costs no flash
+ * beyond the table itself and no runtime math:
+ *
+ *   inline constexpr auto myGamma = GAMMA::MakeGammaLut8(2.35);
+ *   inline constexpr auto myCurves = GAMMA::MakeChannelGammaLut8(2.2, 2.2, 2.2, 1.8);
+ *
+ * Output matches <https://victornpb.github.io/gamma-table-generator>, which the
+ * named tables at the end of this file used to be pasted from.
+ */
+
+
+namespace GAMMA {
+
+/**
+ * @brief Lookup table of N entries, usable in constant expressions.
+ */
+template<typename T, size_t N>
+struct CurveLut {
+  T Values[N];
+
+  constexpr T operator[](size_t i) const { return Values[i]; }
+  constexpr size_t size() const { return N; }
+};
+
+/**
+ * @brief One curve per channel (R, G, B, W); lets the white LEDs use their own exponent.
+ */
+template<typename T, size_t N>
+struct ChannelCurves {
+  CurveLut<T, N> R;
+  CurveLut<T, N> G;
+  CurveLut<T, N> B;
+  CurveLut<T, N> W;
+
+  constexpr const CurveLut<T, N> &operator[](uint8_t channel) const {
+    return channel == 0 ? R : channel == 1 ? G : channel == 2 ? B : W;
+  }
+};
+
+/* --- constexpr math (std::pow is not constexpr) --- */
+
+constexpr double kLn2 = 0.69314718055994530942;
+
+/**
+ * Natural logarithm for x > 0: reduce to [1, 2) by powers of two, then atanh series.
+ */
+constexpr double Ln(double x) {
+  int k = 0;
+  while (x >= 2.0) {
+    x *= 0.5;
+    ++k;
+  }
+  while (x < 1.0) {
+    x *= 2.0;
+    --k;
+  }
+  const double y = (x - 1.0) / (x + 1.0);
+  const double y2 = y * y;
+  double term = y;
+  double sum = 0.0;
+  for (int n = 1; n < 60; n += 2) {
+    sum += term / n;
+    term *= y2;
+  }
+  return 2.0 * sum + k * kLn2;
+}
+
+/**
+ * e^x: split off a power of two so the Taylor series runs on |r| <= ln2 / 2.
+ */
+constexpr double Exp(double x) {
+  const int k = static_cast<int>(x / kLn2 + (x < 0.0 ? -0.5 : 0.5));
+  const double r = x - k * kLn2;
+  double term = 1.0;
+  double sum = 1.0;
+  for (int n = 1; n < 30; ++n) {
+    term *= r / n;
+    sum += term;
+  }
+  double scale = 1.0;
+  for (int i = 0; i < k; ++i) scale *= 2.0;
+  for (int i = 0; i > k; --i) scale *= 0.5;
+  return sum * scale;
+}
+
+/**
+ * base^exponent for base in [0, 1] and exponent > 0 (the only range curves need).
+ */
+constexpr double Pow(double base, double exponent) {
+  if (base <= 0.0) return 0.0;
+  if (base >= 1.0) return 1.0;
+  return Exp(exponent * Ln(base));
+}
+
+/* --- generators --- */
+
+/**
+ * @brief Table[i] = round((i / (N - 1))^exponent * maxValue).
+ *
+ * exponent 1.0 gives a linear ramp, ~2.2 a display gamma, 3.0 a cubic fade curve.
+ */
+template<typename T, size_t N = 256>
+constexpr CurveLut<T, N> MakeCurve(double exponent, T maxValue) {
+  CurveLut<T, N> lut{};
+  for (size_t i = 0; i < N; ++i) {
+    const double x = static_cast<double>(i) / static_cast<double>(N - 1);
+    lut.Values[i] = static_cast<T>(Pow(x, exponent) * static_cast<double>(maxValue) + 0.5);
+  }
+  return lut;
+}
+
+/**
+ * @brief 8-bit gamma table (0..255 -> 0..255).
+ */
+constexpr CurveLut<uint8_t, 256> MakeGammaLut8(double gamma) {
+  return MakeCurve<uint8_t, 256>(gamma, 255);
+}
+
+/**
+ * @brief 16-bit gamma table (0..255 -> 0..65535), for pipelines that keep more output precision.
+ */
+constexpr CurveLut<uint16_t, 256> MakeGammaLut16(double gamma) {
+  return MakeCurve<uint16_t, 256>(gamma, 65535);
+}
+
+/**
+ * @brief Per-channel 8-bit gamma tables.
+ */
+constexpr ChannelCurves<uint8_t, 256> MakeChannelGammaLut8(double r, double g, double b, double w) {
+  return { MakeGammaLut8(r), MakeGammaLut8(g), MakeGammaLut8(b), MakeGammaLut8(w) };
+}
+
+/**
+ * @brief Per-channel 16-bit gamma tables.
+ */
+constexpr ChannelCurves<uint16_t, 256> MakeChannelGammaLut16(double r, double g, double b, double w) {
+  return { MakeGammaLut16(r), MakeGammaLut16(g), MakeGammaLut16(b), MakeGammaLut16(w) };
+}
+
+}  // namespace GAMMA
+
+
+
+// Named 8-bit gamma tables (steps = 256, range = 0-255)
+inline constexpr GAMMA::CurveLut<uint8_t, 256> gammaLut8_160 = GAMMA::MakeGammaLut8(1.60);
+inline constexpr GAMMA::CurveLut<uint8_t, 256> gammaLut8_180 = GAMMA::MakeGammaLut8(1.80);
+inline constexpr GAMMA::CurveLut<uint8_t, 256> gammaLut8_200 = GAMMA::MakeGammaLut8(2.00);
+inline constexpr GAMMA::CurveLut<uint8_t, 256> gammaLut8_220 = GAMMA::MakeGammaLut8(2.20);
+inline constexpr GAMMA::CurveLut<uint8_t, 256> gammaLut8_240 = GAMMA::MakeGammaLut8(2.40);
+inline constexpr GAMMA::CurveLut<uint8_t, 256> gammaLut8_260 = GAMMA::MakeGammaLut8(2.60);
+
+// spot checks against the previously pasted tables
+static_assert(gammaLut8_160[128] == 85 && gammaLut8_220[15] == 1 && gammaLut8_220[254] == 253, "gamma generator drifted");
@@ -0,0 +1,512 @@
+//////////////////////////////////
+//      LED EFFECT ENGINE       //
+//////////////////////////////////
+#pragma once
+#include <Arduino.h>
+#include "210_LED_CORE.h"
+
+/**
+ * @file 230_LED_EFFECTS.h
+ * @brief Registry of effect kernels that modulate LED::CORE::Vars::Scale.
+ *
+ * An effect is an EffectKernel entry in kEffects: a name, the Scale channels
+ * it drives and plain reset/step/render functions. Kernels keep their state in
+ * their own function-local static, so the engine never allocates. Run() ticks
+ * the kernel selected by Config::effectIndex against the elapsed time: shifting
+ * kernels push one new scale per channel and effect step into the rings,
+ * rendering kernels rewrite the whole window of each channel. Channels outside the kernel's mask
+ * are left alone.
+ *
+ * Adding an effect = one namespace with Reset() and Step() or Render(), plus
+ * one kEffects row.
+ */
+
+namespace LED {
+namespace EFFECTS {
+
+/**
+ * @brief xorshift32 generator shared by the effect kernels.
+ *
+ * One word of state and three shift/xor pairs per draw, so effects never touch
+ * the global rand()/random() state and replay exactly for a given seed.
+ */
+struct EffectRng {
+  uint32_t state = 0x9E3779B9u;
+
+  void Seed(uint32_t value) {
+    // murmur3 finalizer: spreads small seeds and never leaves the state at 0
+    uint32_t x = value ^ 0x9E3779B9u;
+    x ^= x >> 16;
+    x *= 0x85EBCA6Bu;
+    x ^= x >> 13;
+    x *= 0xC2B2AE35u;
+    x ^= x >> 16;
+    state = (x != 0) ? x : 0x9E3779B9u;
+  }
+
+  uint32_t Next() {
+    uint32_t x = state;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    state = x;
+    return x;
+  }
+
+  /// Uniform in [minValue, maxValue) with 24 bits of resolution.
+  float NextFloat(float minValue, float maxValue) {
+    const float r = static_cast<float>(Next() >> 8) * (1.0f / 16777216.0f);
+    return minValue + r * (maxValue - minValue);
+  }
+
+  /// Uniform in [minValue, maxValue], both inclusive (multiply-shift, no division).
+  int32_t NextInt(int32_t minValue, int32_t maxValue) {
+    if (maxValue <= minValue) return minValue;
+    const uint32_t range = static_cast<uint32_t>(maxValue - minValue) + 1u;
+    return minValue + static_cast<int32_t>((static_cast<uint64_t>(Next()) * range) >> 32);
+  }
+};
+
+/**
+ * @brief One registered effect.
+ *
+ * reset(start) restarts the kernel from the scales currently shown (start[c]
+ * for every channel c). A kernel then either
+ *  - shifts: step(out) advances one tick and writes the new scale of every
+ *    channel in `channels` to out[c], which is shifted into the strip, or
+ *  - renders: render(c, window, count) writes the scale of all `count`
+ *    pixels of channel c directly and returns whether any of them changed.
+ * The other function pointer is nullptr.
+ */
+struct EffectKernel {
+  const char *name;
+  uint8_t channels;  ///< bit c set: the kernel drives Scale channel c
+  void (*reset)(const float *start);
+  void (*step)(float *out);
+  bool (*render)(uint8_t channel, CORE::ScaleSample *window, size_t count);
+};
+
+constexpr uint8_t kNoEffect = 0xFF;
+
+/**
+ * @brief Engine state: generator, applied seed and the kernel currently running.
+ */
+struct Engine {
+  EffectRng Rng;
+  uint32_t seed = 0;         ///< Config::effectSeed the generator was seeded with
+  bool seeded = false;
+  uint8_t running = kNoEffect;
+  uint32_t stepPhase = 0;    ///< effect steps owed, in 1/1000 steps
+  size_t idleSteps = 0;      ///< steps since the effect was switched off
+  uint32_t runMs = 0;        ///< elapsed time Run() fed the kernel since its (re)start; clock of rendering kernels
+};
+
+inline Engine &GetEngine() {
+  static Engine e;
+  return e;
+}
+
+/**
+ * Scale rings shift in opposite directions on neighbouring channels, so the
+ * four channels drift across the strip against each other.
+ */
+constexpr bool kForward[4] = { true, false, true, false };
+
+
+
+//////// RANDOM WALK ////////
+// Every channel eases (smoothstep) to a random amplitude in
+// [effectMinAmplitude, effectMaxAmplitude], holds it, and picks the next one.
+namespace RANDOM_WALK {
+
+struct Channel {
+  float prev;
+  float next;
+  float currentOutput;
+  uint32_t numSteps;
+  uint32_t currentStep;
+  bool hold;
+};
+
+inline Channel *GetChannels() {
+  static Channel channels[4];
+  return channels;
+}
+
+inline void Reset(const float *start) {
+  Channel *ch = GetChannels();
+  for (int n = 0; n < 4; n++) {
+    ch[n].prev = start[n];
+    ch[n].next = start[n];
+    ch[n].currentOutput = start[n];
+    ch[n].numSteps = 0;
+    ch[n].currentStep = 1;
+    ch[n].hold = 0;
+  }
+}
+
+inline void Step(float *out) {
+  const CORE::Config &c = CORE::GetConfig();
+  EffectRng &rng = GetEngine().Rng;
+  Channel *ch = GetChannels();
+
+  auto mapFloatToFloat = [](float x, float x0, float x1, float y0, float y1) {
+    if (x <= x0) return y0;
+    if (x >= x1) return y1;
+    const float t = (x - x0) / (x1 - x0);
+    return y0 + t * (y1 - y0);
+  };
+
+  auto applySmoothInterpolation = [](float t) {
+    t = constrain(t, 0.0f, 1.0f);
+    return t * t * (3.0f - 2.0f * t);
+  };
+
+  for (int n = 0; n < 4; n++) {
+    if (ch[n].currentStep > ch[n].numSteps) {
+      ch[n].prev = ch[n].next;
+
+      if (ch[n].hold) {
+        ch[n].numSteps = rng.NextInt(c.effectHoldMinSteps, c.effectHoldMaxSteps);
+      } else {
+        ch[n].next = rng.NextFloat(c.effectMinAmplitude, c.effectMaxAmplitude);
+        float diff = ch[n].next - ch[n].prev;
+        float diffMappedSteps = mapFloatToFloat(diff, c.effectMinAmplitude, c.effectMaxAmplitude, c.effectEvolveMinSteps, c.effectEvolveMaxSteps);
+
+        ch[n].numSteps = (uint32_t)(diffMappedSteps * rng.NextFloat(0.8, 1.2));
+      }
+      ch[n].hold = !ch[n].hold;
+      ch[n].currentStep = 0;
+    }
+
+    float diff = ch[n].next - ch[n].prev;
+    float progress = (float)ch[n].currentStep / (float)ch[n].numSteps;
+    ch[n].currentOutput = ch[n].prev + applySmoothInterpolation(progress) * diff;
+
+    ++ch[n].currentStep;
+    out[n] = ch[n].currentOutput;
+  }
+}
+
+}  // namespace RANDOM_WALK
+
+
+
+//////// NOISE ////////
+// 2D value noise over (pixel, time), evaluated per pixel in Q16 and mapped
+// onto [effectMinAmplitude, effectMaxAmplitude]. Nothing is shifted, and time
+// is Engine::runMs (the elapsed time handed to Run()), so the drift speed
+// (effectNoiseSpeed cells/s) is independent of effectIntervalMs and tick jitter.
+// Lattice values are interpolated in time once per noise cell; per pixel the
+// work is one smoothstep and one blend between the two neighbouring cells.
+namespace NOISE {
+
+/**
+ * @brief Everything a rendered window depends on; equal keys mean equal windows.
+ */
+struct Key {
+  uint32_t salt;
+  uint32_t ti;
+  uint32_t tf;
+  uint32_t step;
+  float minAmplitude;
+  float maxAmplitude;
+  size_t count;
+
+  bool operator==(const Key &o) const {
+    return salt == o.salt && ti == o.ti && tf == o.tf && step == o.step
+           && minAmplitude == o.minAmplitude && maxAmplitude == o.maxAmplitude && count == o.count;
+  }
+};
+
+struct State {
+  uint32_t salt = 0;      ///< drawn from the seeded generator on reset
+  Key Rendered[4];        ///< key of the window last written per channel
+  bool valid[4] = { false, false, false, false };
+};
+
+inline State &GetState() {
+  static State s;
+  return s;
+}
+
+/**
+ * @brief Lattice value in [0, 65535] at cell `x`, time step `t` of `channel`.
+ */
+inline uint32_t Lattice(uint32_t salt, uint32_t x, uint32_t t, uint8_t channel) {
+  uint32_t h = salt ^ (x * 0x9E3779B1u) ^ (t * 0x85EBCA77u) ^ (static_cast<uint32_t>(channel) * 0xC2B2AE3Du);
+  h ^= h >> 16;
+  h *= 0x7FEB352Du;
+  h ^= h >> 15;
+  h *= 0x846CA68Bu;
+  h ^= h >> 16;
+  return h & 0xFFFFu;
+}
+
+/**
+ * @brief Smoothstep of a Q16 fraction f in [0, 1): f*f*(3-2f), kept within 32 bits.
+ */
+inline uint32_t Smooth16(uint32_t f) {
+  const uint32_t f2 = (f * f) >> 16;
+  return (f2 * ((3u * 65536u - 2u * f) >> 2)) >> 14;
+}
+
+/**
+ * @brief a + (b - a) * f for Q16 values a, b and Q16 fraction f.
+ */
+inline uint32_t Lerp16(uint32_t a, uint32_t b, uint32_t f) {
+  return static_cast<uint32_t>(static_cast<int32_t>(a) + ((static_cast<int32_t>(b) - static_cast<int32_t>(a)) * static_cast<int32_t>(f >> 1) >> 15));
+}
+
+inline void Reset(const float *start) {
+  (void)start;
+  State &s = GetState();
+  s.salt = GetEngine().Rng.Next();
+  for (uint8_t channel = 0; channel < 4; ++channel) s.valid[channel] = false;
+}
+
+inline bool Render(uint8_t channel, CORE::ScaleSample *window, size_t count) {
+  const CORE::Config &c = CORE::GetConfig();
+  State &s = GetState();
+
+  // position and time in Q16 noise cells
+  const float cellPixels = max(c.effectNoiseScale, 1.0f);
+  const uint32_t step = static_cast<uint32_t>(65536.0f / cellPixels);
+  const uint64_t elapsedMs = GetEngine().runMs;
+  const uint64_t time = elapsedMs * static_cast<uint64_t>(max(c.effectNoiseSpeed, 0.0f) * 65536.0f) / 1000u;
+  const uint32_t ti = static_cast<uint32_t>(time >> 16);
+  const uint32_t tf = Smooth16(static_cast<uint32_t>(time & 0xFFFFu));
+
+  // a slow drift often lands on the same time fraction as the last tick
+  const Key key = { s.salt, ti, tf, step, c.effectMinAmplitude, c.effectMaxAmplitude, count };
+  if (s.valid[channel] && s.Rendered[channel] == key) return false;
+  s.Rendered[channel] = key;
+  s.valid[channel] = true;
+
+  auto column = [&](uint32_t xi) {
+    return Lerp16(Lattice(s.salt, xi, ti, channel), Lattice(s.salt, xi, ti + 1, channel), tf);
+  };
+
+  // noise n (Q16) -> scale sample: min + n * (max - min)
+#if LED_CORE_FIXED_POINT
+  const int32_t base = CORE::ToScaleSample(c.effectMinAmplitude);
+  const int32_t range = static_cast<int32_t>(CORE::ToScaleSample(c.effectMaxAmplitude)) - base;
+  auto toSample = [&](uint32_t n) {
+    return static_cast<CORE::ScaleSample>(base + ((range * static_cast<int32_t>(n >> 1)) >> 15));
+  };
+#else
+  const float base = c.effectMinAmplitude;
+  const float range = (c.effectMaxAmplitude - c.effectMinAmplitude) * (1.0f / 65536.0f);
+  auto toSample = [&](uint32_t n) { return base + static_cast<float>(n) * range; };
+#endif
+
+  uint32_t x = 0;
+  uint32_t a = column(0);
+
+  // one noise cell per outer iteration; the pixel loop inside has no branches
+  for (size_t i = 0, xi = 0; i < count; ++xi) {
+    const uint32_t b = column(static_cast<uint32_t>(xi) + 1);
+    const uint32_t cellEnd = static_cast<uint32_t>(xi + 1) << 16;
+    const size_t end = min(count, i + (cellEnd - x + step - 1) / step);
+
+    for (; i < end; ++i, x += step) {
+      window[i] = toSample(Lerp16(a, b, Smooth16(x & 0xFFFFu)));
+    }
+    a = b;
+  }
+  return true;
+}
+
+}  // namespace NOISE
+
+
+
+//////// REGISTRY ////////
+
+inline constexpr EffectKernel kEffects[] = {
+  { "RANDOM_WALK", 0x0F, &RANDOM_WALK::Reset, &RANDOM_WALK::Step, nullptr },
+  { "NOISE", 0x0F, &NOISE::Reset, nullptr, &NOISE::Render },
+};
+
+constexpr uint8_t kEffectCount = sizeof(kEffects) / sizeof(kEffects[0]);
+
+/**
+ * @brief Registry index of the effect called `name` (case-insensitive), or kNoEffect.
+ */
+inline uint8_t FindEffect(const char *name) {
+  for (uint8_t i = 0; i < kEffectCount; ++i) {
+    if (strcasecmp(name, kEffects[i].name) == 0) return i;
+  }
+  return kNoEffect;
+}
+
+/**
+ * @brief Forget the running kernel and the seed; the next Run() starts over.
+ */
+inline void Init() {
+  Engine &e = GetEngine();
+  e.seeded = false;
+  e.running = kNoEffect;
+  e.stepPhase = 0;
+  e.idleSteps = 0;
+  e.runMs = 0;
+}
+
+/**
+ * @brief (Re)start kernel `index` from Config::effectSeed.
+ *
+ * Switching kernels resets every scale to 1.0 first; a reseed of the running
+ * kernel continues from the scales currently shown, so lamps given the same
+ * seed run in step without a visible jump.
+ */
+inline void Restart(uint8_t index) {
+  Engine &e = GetEngine();
+  CORE::Vars &v = CORE::GetVars();
+  const CORE::Config &c = CORE::GetConfig();
+
+  if (index != e.running) {
+    v.Scale.Reset(v.Count, CORE::ToScaleSample(1.0f));
+    CORE::MarkRenderDirty();
+    e.running = index;
+  }
+
+  e.seed = c.effectSeed;
+  e.runMs = 0;
+  e.Rng.Seed(c.effectSeed != 0 ? c.effectSeed : static_cast<uint32_t>(random(1, 0x7FFFFFFF)));
+  e.seeded = true;
+
+  float start[4];
+  for (uint8_t channel = 0; channel < 4; ++channel) {
+    start[channel] = CORE::FromScaleSample(v.Scale.Last[channel]);
+  }
+  kEffects[index].reset(start);
+}
+
+/**
+ * @brief Stop the running kernel; rendered channels become shiftable rings again.
+ */
+inline void Leave() {
+  Engine &e = GetEngine();
+  CORE::Vars &v = CORE::GetVars();
+
+  const EffectKernel &kernel = kEffects[e.running];
+  if (kernel.render) {
+    for (uint8_t channel = 0; channel < 4; ++channel) {
+      if (kernel.channels & (1u << channel)) v.Scale.Mirror(channel);
+    }
+  }
+  e.running = kNoEffect;
+  e.idleSteps = 0;
+}
+
+/**
+ * @brief Set Config::effectSeed and restart the effect from it, even if the seed is unchanged.
+ */
+inline void SetSeed(uint32_t seed) {
+  CORE::GetConfig().effectSeed = seed;
+  GetEngine().seeded = false;
+  CORE::MarkChangeInConfig();
+}
+
+/**
+ * @brief Select the effect at registry index `index`.
+ * @return false if no such effect is registered.
+ */
+inline bool Select(uint8_t index) {
+  if (index >= kEffectCount) return false;
+  CORE::GetConfig().effectIndex = index;
+  CORE::MarkChangeInConfig();
+  return true;
+}
+
+/**
+ * @brief True once the effect is off and the strip has slid back to 1.0, i.e. Run() has nothing left to do.
+ */
+inline bool IsSettled() {
+  const Engine &e = GetEngine();
+  return !CORE::GetConfig().effectActive && e.running == kNoEffect && e.idleSteps >= CORE::GetVars().Count;
+}
+
+/**
+ * @brief Whole effect steps due for `elapsedMs` at Config::effectStepsPerSecond.
+ *
+ * Fractions carry over in Engine::stepPhase (milli-steps), so the step rate
+ * does not depend on how often Run() is called. At most `limit` steps are
+ * returned; more would shift the whole strip past anyway.
+ */
+inline size_t DueSteps(uint32_t elapsedMs, size_t limit) {
+  Engine &e = GetEngine();
+  const float rate = max(CORE::GetConfig().effectStepsPerSecond, 0.0f);
+
+  // a stall of hours only owes `limit` steps; keep the product well inside uint32_t
+  e.stepPhase += static_cast<uint32_t>(min(static_cast<float>(elapsedMs) * rate, 1e9f) + 0.5f);
+  const size_t steps = e.stepPhase / 1000u;
+  e.stepPhase -= static_cast<uint32_t>(steps) * 1000u;
+  return min(steps, limit);
+}
+
+/**
+ * @brief Advance the effect by the time elapsed since the last call.
+ *
+ * Shifting kernels take one step per due effect step and shift each output
+ * into Scale; rendering kernels evaluate Engine::runMs, which only this call
+ * advances (not on the call that (re)starts the kernel). With the effect
+ * switched off, 1.0 is shifted into every channel until the whole strip is back
+ * at 1.0 (at once if effectStepsPerSecond is 0); after that the call does nothing.
+ */
+inline void Run(uint32_t elapsedMs) {
+  Engine &e = GetEngine();
+  const CORE::Config &c = CORE::GetConfig();
+  CORE::Vars &v = CORE::GetVars();
+
+  if (!c.effectActive) {
+    if (e.running != kNoEffect) Leave();
+    const size_t remaining = v.Count - min(e.idleSteps, v.Count);
+    // at a step rate of 0 (settings saved before it was rejected) the slide would never end
+    const size_t steps = (c.effectStepsPerSecond > 0.0f) ? DueSteps(elapsedMs, remaining) : remaining;
+    for (size_t step = 0; step < steps; ++step) {
+      for (uint8_t channel = 0; channel < 4; ++channel) {
+        CORE::ShiftScaleChannel(1.0f, channel, kForward[channel]);
+      }
+    }
+    e.idleSteps += steps;
+    return;
+  }
+  e.idleSteps = 0;
+
+  const uint8_t index = (c.effectIndex < kEffectCount) ? c.effectIndex : 0;
+  const bool restart = index != e.running || !e.seeded || e.seed != c.effectSeed;
+  if (restart) Restart(index);
+
+  const EffectKernel &kernel = kEffects[index];
+
+  if (kernel.render) {
+    if (v.Count == 0) return;
+    if (v.Scale.Length != v.Count) v.Scale.Reset(v.Count, CORE::ToScaleSample(1.0f));
+    if (!restart) e.runMs += elapsedMs;
+
+    bool changed = false;
+    for (uint8_t channel = 0; channel < 4; ++channel) {
+      if (kernel.channels & (1u << channel)) {
+        changed |= kernel.render(channel, v.Scale.Overwrite(channel), v.Count);
+      }
+    }
+    if (changed) CORE::MarkRenderDirty();
+    return;
+  }
+
+  const size_t steps = DueSteps(elapsedMs, v.Count);
+  for (size_t step = 0; step < steps; ++step) {
+    float out[4];
+    kernel.step(out);
+
+    for (uint8_t channel = 0; channel < 4; ++channel) {
+      if (kernel.channels & (1u << channel)) {
+        CORE::ShiftScaleChannel(out[channel], channel, kForward[channel]);
+      }
+    }
+  }
+}
+
+}  // namespace EFFECTS
+}  // namespace LED
@@ -0,0 +1,168 @@
+//////////////////////////////////
+//     LED FRAME STATISTICS     //
+//////////////////////////////////
+#pragma once
+#include <Arduino.h>
+
+/**
+ * @file 240_LED_STATS.h
+ * @brief Per-stage timing of LED::Update() in fixed-size log2 histograms.
+ *
+ * LED::Update() wraps every stage (Fade, gradient, output scaling, HAL write and show,
+ * effect tick and the whole frame) in a StageTimer that reads the CPU cycle
+ * counter. Each stage keeps count/min/max/sum and a histogram with one bucket
+ * per power of two, so recording is a handful of integer ops and RAM use is
+ * fixed. RecordTick() tracks how late the processing tick ran against
+ * Config::processingIntervalMs and counts missed deadlines.
+ *
+ * Read with the console command STATS, clear with STATS RESET.
+ */
+
+// Frame-time instrumentation:
+//  0 = StageTimer/RecordTick compile to nothing
+//  1 = cycle-counter timing of every LED::Update() stage (about 1 KB RAM)
+#ifndef LED_STATS
+#define LED_STATS 1
+#endif
+
+namespace LED {
+namespace STATS {
+
+enum Stage : uint8_t {
+  FADE,
+  GRADIENT,  ///< ComputeGradient() (two-pass builds)
+  SCALING,   ///< ApplyOutputScaling() (two-pass builds)
+  RENDER,    ///< fused RenderFrame() (LED_CORE_FUSED)
+  SHOW,      ///< UpdateColor(): HAL write and show
+  EFFECT,
+  FRAME,     ///< whole processing tick, Fade to show
+  STAGE_COUNT
+};
+
+inline constexpr const char* kStageNames[STAGE_COUNT] = {
+  "Fade", "Gradient", "Scaling", "Render", "Show", "Effect", "Frame"
+};
+
+inline constexpr uint8_t kBuckets = 32;  ///< bucket b holds values in [2^b, 2^(b+1)), bucket 0 also holds 0
+
+/**
+ * @brief Fixed-size log2 histogram of uint32_t samples.
+ */
+struct Histogram {
+  uint32_t count = 0;
+  uint32_t minValue = UINT32_MAX;
+  uint32_t maxValue = 0;
+  uint64_t sum = 0;
+  uint32_t bucket[kBuckets] = {};
+
+  void Add(uint32_t value) {
+    ++count;
+    sum += value;
+    if (value < minValue) minValue = value;
+    if (value > maxValue) maxValue = value;
+    ++bucket[value ? 31 - __builtin_clz(value) : 0];
+  }
+
+  uint32_t Average() const { return count ? static_cast<uint32_t>(sum / count) : 0; }
+
+  /**
+   * @brief Upper bound of the bucket holding the `perMille`/1000 quantile, capped at maxValue.
+   */
+  uint32_t Percentile(uint16_t perMille) const {
+    if (count == 0) return 0;
+    const uint64_t rank = (static_cast<uint64_t>(count) * perMille + 999) / 1000;
+    uint64_t seen = 0;
+    for (uint8_t b = 0; b < kBuckets; ++b) {
+      seen += bucket[b];
+      if (seen >= rank) {
+        const uint32_t upper = (b == 31) ? UINT32_MAX : ((2u << b) - 1u);
+        return upper < maxValue ? upper : maxValue;
+      }
+    }
+    return maxValue;
+  }
+};
+
+struct Stats {
+  Histogram stage[STAGE_COUNT];  ///< CPU cycles per stage
+  Histogram lateness;            ///< ms the processing tick ran after it was due
+  uint32_t missedDeadlines = 0;  ///< ticks that slipped by a whole processing interval or more
+  uint32_t sinceMs = 0;          ///< millis() of the last Reset()
+};
+
+inline Stats& GetStats() {
+  static Stats stats;
+  return stats;
+}
+
+inline void Reset() {
+  Stats &stats = GetStats();
+  stats = Stats();
+  stats.sinceMs = millis();
+}
+
+/**
+ * @brief Free-running CPU cycle counter (micros() where the core has none).
+ */
+inline uint32_t CycleCount() {
+#if defined(ARDUINO_ARCH_ESP32)
+  return ESP.getCycleCount();
+#else
+  return micros();
+#endif
+}
+
+inline uint32_t CyclesPerMicrosecond() {
+#if defined(ARDUINO_ARCH_ESP32)
+  return getCpuFrequencyMhz();
+#else
+  return 1;
+#endif
+}
+
+inline void Record(Stage stage, uint32_t cycles) {
+#if LED_STATS
+  GetStats().stage[stage].Add(cycles);
+#else
+  (void)stage;
+  (void)cycles;
+#endif
+}
+
+/**
+ * @brief Account one processing tick that ran `elapsedMs` after the previous one.
+ *
+ * LED::Update() runs the tick once more than `intervalMs` have passed, so it is
+ * due at intervalMs + 1; a tick that is late by another whole interval missed
+ * its slot.
+ */
+inline void RecordTick(uint32_t elapsedMs, uint32_t intervalMs) {
+#if LED_STATS
+  Stats &stats = GetStats();
+  const uint32_t due = intervalMs + 1;
+  const uint32_t late = (elapsedMs > due) ? elapsedMs - due : 0;
+  stats.lateness.Add(late);
+  if (late >= due) ++stats.missedDeadlines;
+#else
+  (void)elapsedMs;
+  (void)intervalMs;
+#endif
+}
+
+/**
+ * @brief Times its own scope into the given stage.
+ */
+struct StageTimer {
+#if LED_STATS
+  explicit StageTimer(Stage stage) : stage(stage), start(CycleCount()) {}
+  ~StageTimer() { Record(stage, CycleCount() - start); }
+
+  Stage stage;
+  uint32_t start;
+#else
+  explicit StageTimer(Stage) {}
+#endif
+};
+
+}  // namespace STATS
+}  // namespace LED
@@ -38,9 +38,12 @@ void HandleSET_COLOR(const char* pos);
 void HandleSET_BRIGHTNESS(const char* pos);
 void HandleSET_PARAM(const char* pos);
 void HandleSET_GRADIENT(const char* pos);
+void HandleSET_EFFECT(const char* pos);
 void HandleTOGGLE(const char* pos);
 void HandleSYSTEM(const char* pos);
 void HandleSYSTEM_RESET(const char* pos);
+void HandleSTATS(const char* pos);
+void HandleTRACE(const char* pos);
 
 // Help output
 void PrintHelpTop();
@@ -48,9 +51,13 @@ void PrintHelpPredefinedColors();
 void PrintHelpSet();
 void PrintHelpSetParam();
 void PrintHelpSetGradient();
+void PrintHelpSetEffect();
 void PrintHelpToggle();
 void PrintHelpSystem();
+void PrintHelpStats();
+void PrintHelpTrace();
 void PrintGradientSettings();
+void PrintStats();
 
 // Parsing / helper utilities
 bool ParseColorName(const char* name, LED::Pixel_byte& out);
@@ -148,8 +155,13 @@ inline void Process() {
 inline void EvaluateCommand(const char* line) {
   if (!line || !*line) return;
 
+  TRACE::Scope trace(TRACE::CONSOLE_COMMAND);
+
   PrintCommandEcho(line);
 
+  // no blanket LED::Wake(): commands that change state wake the loop through
+  // LED::MarkChangeInConfig() (or the mirror setters); HELP, STATS, TRACE leave it parked
+
   const char* p = TrimLeading(line);
 
   // HELP commands
@@ -180,6 +192,20 @@ inline void EvaluateCommand(const char* line) {
     return;
   }
 
+  // STATS commands
+  if (strncasecmp(p, "STATS", 5) == 0) {
+    HandleSTATS(p + 5);
+    PrintResponseBlankLine();
+    return;
+  }
+
+  // TRACE commands
+  if (strncasecmp(p, "TRACE", 5) == 0) {
+    HandleTRACE(p + 5);
+    PrintResponseBlankLine();
+    return;
+  }
+
   // SAVE commands
   if (strncasecmp(p, "SAVE", 4) == 0) {
     //ProvokeImmediateSaveOfConfig();
@@ -265,6 +291,10 @@ inline void HandleHELP(const char* pos) {
       PrintHelpSetGradient();
       return;
     }
+    if (strncasecmp(s, "EFFECT", 6) == 0) {
+      PrintHelpSetEffect();
+      return;
+    }
     // unknown subtopic after SET -> show SET help
     PrintHelpSet();
     return;
@@ -280,8 +310,18 @@ inline void HandleHELP(const char* pos) {
     return;
   }
 
+  if (strncasecmp(s, "STATS", 5) == 0) {
+    PrintHelpStats();
+    return;
+  }
+
+  if (strncasecmp(s, "TRACE", 5) == 0) {
+    PrintHelpTrace();
+    return;
+  }
+
   // Unknown help topic -> fallback to top-level + hint
-  PrintResponseLine(F("Unknown HELP topic. Valid: HELP, HELP PREDEFINED, HELP SET, HELP SET PARAM, HELP SET GRADIENT, HELP TOGGLE, HELP SYSTEM"));
+  PrintResponseLine(F("Unknown HELP topic. Valid: HELP, HELP PREDEFINED, HELP SET, HELP SET PARAM, HELP SET GRADIENT, HELP SET EFFECT, HELP TOGGLE, HELP SYSTEM, HELP STATS, HELP TRACE"));
   PrintHelpTop();
 }
 
@@ -329,7 +369,13 @@ inline void HandleSET(const char* pos) {
     return;
   }
 
-  PrintResponseLine(F("SET: unknown subcommand. Valid: COLOR, BRIGHTNESS, PARAM, GRADIENT. Type HELP."));
+  if (strncasecmp(pos, "EFFECT", 6) == 0) {
+    pos += 6;
+    HandleSET_EFFECT(pos);
+    return;
+  }
+
+  PrintResponseLine(F("SET: unknown subcommand. Valid: COLOR, BRIGHTNESS, PARAM, GRADIENT, EFFECT. Type HELP."));
 }
 
 inline void HandleTOGGLE(const char* pos) {
@@ -418,6 +464,48 @@ inline void HandleSYSTEM_RESET(const char* pos) {
   ScheduleSystemRestart(10000UL);
 }
 
+inline void HandleSTATS(const char* pos) {
+  if (pos) {
+    while (*pos == ' ' || *pos == '\t') ++pos;
+  }
+
+  if (!pos || !*pos) {
+    PrintStats();
+    return;
+  }
+
+  if (strncasecmp(pos, "RESET", 5) == 0) {
+    LED::STATS::Reset();
+    PrintResponseLine(F("Frame statistics cleared."));
+    return;
+  }
+
+  PrintResponseLine(F("STATS: unknown subcommand. Valid: RESET. Type HELP STATS."));
+}
+
+inline void HandleTRACE(const char* pos) {
+  if (pos) {
+    while (*pos == ' ' || *pos == '\t') ++pos;
+  }
+
+  if (!pos || !*pos) {
+#if TRACE_EVENTS
+    TRACE::DumpSerial();
+#else
+    PrintResponseLine(F("TRACE: event tracing is compiled out (TRACE_EVENTS 0)."));
+#endif
+    return;
+  }
+
+  if (strncasecmp(pos, "CLEAR", 5) == 0) {
+    TRACE::Clear();
+    PrintResponseLine(F("Trace buffer cleared."));
+    return;
+  }
+
+  PrintResponseLine(F("TRACE: unknown subcommand. Valid: CLEAR. Type HELP TRACE."));
+}
+
 /* ------------------ SET subcommand handlers --------------------------- */
 
 inline void HandleSET_COLOR(const char* pos) {
@@ -555,9 +643,9 @@ inline void HandleSET_PARAM(const char* pos) {
           PrintResponseLine(F("SET PARAM 1: value must be > 0"));
           return;
         }
-        cfg.colorIncrement = value;
+        cfg.colorFadePerSecond = value;
         LED::MarkChangeInConfig();
-        PrintResponseLineFmt("Color increment set to %.3f.", static_cast<double>(cfg.colorIncrement));
+        PrintResponseLineFmt("Color fade rate set to %.3f/s.", static_cast<double>(cfg.colorFadePerSecond));
         return;
       }
       case 2: {
@@ -566,9 +654,9 @@ inline void HandleSET_PARAM(const char* pos) {
           PrintResponseLine(F("SET PARAM 2: value must be > 0"));
           return;
         }
-        cfg.brightnessIncrement = value;
+        cfg.brightnessFadePerSecond = value;
         LED::MarkChangeInConfig();
-        PrintResponseLineFmt("Brightness increment set to %.3f.", static_cast<double>(cfg.brightnessIncrement));
+        PrintResponseLineFmt("Brightness fade rate set to %.3f/s.", static_cast<double>(cfg.brightnessFadePerSecond));
         return;
       }
       case 3: {
@@ -577,9 +665,9 @@ inline void HandleSET_PARAM(const char* pos) {
           PrintResponseLine(F("SET PARAM 3: value must be > 0"));
           return;
         }
-        cfg.onoffIncrement = value;
+        cfg.onoffFadePerSecond = value;
         LED::MarkChangeInConfig();
-        PrintResponseLineFmt("On/off increment set to %.3f.", static_cast<double>(cfg.onoffIncrement));
+        PrintResponseLineFmt("On/off fade rate set to %.3f/s.", static_cast<double>(cfg.onoffFadePerSecond));
         return;
       }
       case 4: {
@@ -674,6 +762,51 @@ inline void HandleSET_PARAM(const char* pos) {
         PrintResponseLine(F("SET PARAM 12 has been replaced. Use TOGGLE EFFECT instead."));
         return;
       }
+      case 13: {
+        char* endValue = nullptr;
+        const unsigned long value = strtoul(pos, &endValue, 0);
+        if (endValue == pos || *pos == '-') {
+          PrintResponseLine(F("SET PARAM 13: value must be an unsigned integer"));
+          return;
+        }
+        LED::SetEffectSeed(static_cast<uint32_t>(value));
+        PrintResponseLineFmt("Effect seed set to %lu%s.", static_cast<unsigned long>(cfg.effectSeed),
+                             cfg.effectSeed == 0 ? " (random at startup)" : "");
+        return;
+      }
+      case 14: {
+        float value;
+        if (!ParseFloatToken(pos, value) || value < 1.0f) {
+          PrintResponseLine(F("SET PARAM 14: value must be >= 1"));
+          return;
+        }
+        cfg.effectNoiseScale = value;
+        LED::MarkChangeInConfig();
+        PrintResponseLineFmt("Effect noise scale set to %.1f pixels.", static_cast<double>(cfg.effectNoiseScale));
+        return;
+      }
+      case 15: {
+        float value;
+        if (!ParseFloatToken(pos, value) || value < 0.0f) {
+          PrintResponseLine(F("SET PARAM 15: value must be >= 0"));
+          return;
+        }
+        cfg.effectNoiseSpeed = value;
+        LED::MarkChangeInConfig();
+        PrintResponseLineFmt("Effect noise speed set to %.3f cells/s.", static_cast<double>(cfg.effectNoiseSpeed));
+        return;
+      }
+      case 16: {
+        float value;
+        if (!ParseFloatToken(pos, value) || value <= 0.0f) {
+          PrintResponseLine(F("SET PARAM 16: value must be > 0"));
+          return;
+        }
+        cfg.effectStepsPerSecond = value;
+        LED::MarkChangeInConfig();
+        PrintResponseLineFmt("Effect step rate set to %.1f/s.", static_cast<double>(cfg.effectStepsPerSecond));
+        return;
+      }
       default:
         PrintResponseLine(F("SET PARAM: unknown parameter index. Type 'HELP SET PARAM'."));
         return;
@@ -698,6 +831,32 @@ inline void HandleSET_PARAM(const char* pos) {
   PrintResponseLine(F("SET PARAM: unknown parameter. Type 'HELP SET PARAM' for valid names."));
 }
 
+inline void HandleSET_EFFECT(const char* pos) {
+  if (!pos) {
+    PrintHelpSetEffect();
+    return;
+  }
+
+  while (*pos == ' ' || *pos == '\t') ++pos;
+  if (!*pos) {
+    PrintHelpSetEffect();
+    return;
+  }
+
+  char nameTok[32] = {0};
+  int i = 0;
+  while (*pos && *pos != ' ' && *pos != '\t' && i < (int)sizeof(nameTok) - 1) {
+    nameTok[i++] = *pos++;
+  }
+  nameTok[i] = '\0';
+
+  if (!LED::SetEffect(nameTok)) {
+    PrintResponseLine(F("SET EFFECT: unknown effect. Type HELP SET EFFECT."));
+    return;
+  }
+  PrintResponseLineFmt("Effect set to %s.", LED::EFFECTS::kEffects[LED::GetConfig().effectIndex].name);
+}
+
 inline void HandleSET_GRADIENT(const char* pos) {
   if (!pos) {
     PrintHelpSetGradient();
@@ -849,13 +1008,18 @@ inline void PrintHelpTop() {
   PrintResponseLine(F("                            <sub>: ONOFF, GRADIENT_INVERT, HSL_RGBW, EFFECT"));
   PrintResponseLine(F("  SYSTEM <sub> ...       -> system maintenance commands"));
   PrintResponseLine(F("                            <sub>: RESET"));
+  PrintResponseLine(F("  STATS [RESET]          -> frame timing per stage / clear it"));
+  PrintResponseLine(F("  TRACE [CLEAR]          -> dump recent events as Chrome trace JSON / clear them"));
   PrintResponseLine(F("  HELP                   -> this message"));
   PrintResponseLine(F("  HELP PREDEFINED        -> list named colors"));
   PrintResponseLine(F("  HELP SET               -> show SET subcommands"));
   PrintResponseLine(F("  HELP SET PARAM         -> show available parameters"));
   PrintResponseLine(F("  HELP SET GRADIENT      -> show gradient options"));
+  PrintResponseLine(F("  HELP SET EFFECT        -> show registered effects"));
   PrintResponseLine(F("  HELP TOGGLE            -> show toggle options"));
   PrintResponseLine(F("  HELP SYSTEM            -> show SYSTEM options"));
+  PrintResponseLine(F("  HELP STATS             -> explain the STATS columns"));
+  PrintResponseLine(F("  HELP TRACE             -> show TRACE options"));
 }
 
 inline void PrintHelpPredefinedColors() {
@@ -874,6 +1038,7 @@ inline void PrintHelpSet() {
   PrintResponseLine(F("  SET BRIGHTNESS <0..255>"));
   PrintResponseLine(F("  SET PARAM <index> <value>"));
   PrintResponseLine(F("  SET GRADIENT <sub> ..."));
+  PrintResponseLine(F("  SET EFFECT <name>"));
   PrintResponseLine(F("Type HELP SET GRADIENT for gradient options"));
   PrintResponseLine(F("Type HELP SET PARAM for available parameters"));
 }
@@ -882,22 +1047,40 @@ inline void PrintHelpSetParam() {
   if (!DebugSerialEnabled()) return;
   const auto& cfg = LED::GetConfig();
   PrintResponseLine(F("SET PARAM available parameters (use SET PARAM <index> <value>):"));
-  PrintResponseLineFmt("  1) colorIncrement       | %.3f | Color fade step per update",
-                       static_cast<double>(cfg.colorIncrement));
-  PrintResponseLineFmt("  2) brightnessIncrement  | %.3f | Brightness fade step per update",
-                       static_cast<double>(cfg.brightnessIncrement));
-  PrintResponseLineFmt("  3) onoffIncrement       | %.3f | On/off fade step per update",
-                       static_cast<double>(cfg.onoffIncrement));
-  PrintResponseLineFmt("  4) processingIntervalMs | %lu | LED update interval (ms)",
+  PrintResponseLineFmt("  1) colorFadePerSecond      | %.3f | Color fade rate (0..255 per second)",
+                       static_cast<double>(cfg.colorFadePerSecond));
+  PrintResponseLineFmt("  2) brightnessFadePerSecond | %.3f | Brightness fade rate (0..255 per second)",
+                       static_cast<double>(cfg.brightnessFadePerSecond));
+  PrintResponseLineFmt("  3) onoffFadePerSecond      | %.3f | On/off fade rate (0..1 per second)",
+                       static_cast<double>(cfg.onoffFadePerSecond));
+  PrintResponseLineFmt("  4) processingIntervalMs    | %lu | LED update interval (ms)",
                        static_cast<unsigned long>(cfg.processingIntervalMs));
-  PrintResponseLineFmt("  5) effectIntervalMs     | %lu | Effect timing interval (ms)",
+  PrintResponseLineFmt("  5) effectIntervalMs        | %lu | Effect update interval (ms)",
                        static_cast<unsigned long>(cfg.effectIntervalMs));
-  PrintResponseLineFmt("  6) effectMinAmplitude   | %.3f | Minimum random amplitude", static_cast<double>(cfg.effectMinAmplitude));
-  PrintResponseLineFmt("  7) effectMaxAmplitude   | %.3f | Maximum random amplitude", static_cast<double>(cfg.effectMaxAmplitude));
-  PrintResponseLineFmt("  8) effectEvolveMinSteps | %.0f | Minimum evolve steps", static_cast<double>(cfg.effectEvolveMinSteps));
-  PrintResponseLineFmt("  9) effectEvolveMaxSteps | %.0f | Maximum evolve steps", static_cast<double>(cfg.effectEvolveMaxSteps));
-  PrintResponseLineFmt(" 10) effectHoldMinSteps   | %.0f | Minimum hold steps", static_cast<double>(cfg.effectHoldMinSteps));
-  PrintResponseLineFmt(" 11) effectHoldMaxSteps   | %.0f | Maximum hold steps", static_cast<double>(cfg.effectHoldMaxSteps));
+  PrintResponseLineFmt("  6) effectMinAmplitude      | %.3f | Minimum random amplitude", static_cast<double>(cfg.effectMinAmplitude));
+  PrintResponseLineFmt("  7) effectMaxAmplitude      | %.3f | Maximum random amplitude", static_cast<double>(cfg.effectMaxAmplitude));
+  PrintResponseLineFmt("  8) effectEvolveMinSteps    | %.0f | Minimum evolve steps", static_cast<double>(cfg.effectEvolveMinSteps));
+  PrintResponseLineFmt("  9) effectEvolveMaxSteps    | %.0f | Maximum evolve steps", static_cast<double>(cfg.effectEvolveMaxSteps));
+  PrintResponseLineFmt(" 10) effectHoldMinSteps      | %.0f | Minimum hold steps", static_cast<double>(cfg.effectHoldMinSteps));
+  PrintResponseLineFmt(" 11) effectHoldMaxSteps      | %.0f | Maximum hold steps", static_cast<double>(cfg.effectHoldMaxSteps));
+  PrintResponseLineFmt(" 13) effectSeed              | %lu | Effect random seed (0 = random at startup)",
+                       static_cast<unsigned long>(cfg.effectSeed));
+  PrintResponseLineFmt(" 14) effectNoiseScale        | %.1f | NOISE cell size (pixels)", static_cast<double>(cfg.effectNoiseScale));
+  PrintResponseLineFmt(" 15) effectNoiseSpeed        | %.3f | NOISE drift speed (cells/s)", static_cast<double>(cfg.effectNoiseSpeed));
+  PrintResponseLineFmt(" 16) effectStepsPerSecond    | %.1f | Effect steps (pixels of travel) per second",
+                       static_cast<double>(cfg.effectStepsPerSecond));
+  PrintResponseLine(F("Use TOGGLE EFFECT to enable or disable the effect engine."));
+}
+
+inline void PrintHelpSetEffect() {
+  if (!DebugSerialEnabled()) return;
+  const auto& cfg = LED::GetConfig();
+  PrintResponseLine(F("SET EFFECT usage:"));
+  PrintResponseLine(F("  SET EFFECT <name>"));
+  PrintResponseLine(F("Registered effects:"));
+  for (uint8_t i = 0; i < LED::EFFECTS::kEffectCount; ++i) {
+    PrintResponseLineFmt("  %s%s", LED::EFFECTS::kEffects[i].name, (i == cfg.effectIndex) ? "  (active)" : "");
+  }
   PrintResponseLine(F("Use TOGGLE EFFECT to enable or disable the effect engine."));
 }
 
@@ -929,6 +1112,25 @@ inline void PrintHelpSystem() {
   PrintResponseLine(F("    -> schedules a general 10s restart countdown immediately"));
 }
 
+inline void PrintHelpStats() {
+  if (!DebugSerialEnabled()) return;
+  PrintResponseLine(F("STATS usage:"));
+  PrintResponseLine(F("  STATS          (time per LED::Update() stage since boot or the last reset)"));
+  PrintResponseLine(F("  STATS RESET    (clear all counters)"));
+  PrintResponseLine(F("Stage times are CPU cycles shown in us; p99 is the upper edge of its power-of-two bucket."));
+  PrintResponseLine(F("Lateness is how many ms a processing tick ran after processingIntervalMs; a tick late"));
+  PrintResponseLine(F("by a whole interval or more counts as a missed deadline."));
+}
+
+inline void PrintHelpTrace() {
+  if (!DebugSerialEnabled()) return;
+  PrintResponseLine(F("TRACE usage:"));
+  PrintResponseLine(F("  TRACE          (print the last traced events as Chrome trace JSON)"));
+  PrintResponseLine(F("  TRACE CLEAR    (empty the event ring)"));
+  PrintResponseLine(F("Save the output between the braces as a .json file and open it in"));
+  PrintResponseLine(F("ui.perfetto.dev or chrome://tracing. Timestamps are micros()."));
+}
+
 inline void PrintGradientSettings() {
   if (!DebugSerialEnabled()) return;
 
@@ -951,6 +1153,38 @@ inline void PrintGradientSettings() {
 }
 
 
+inline void PrintStats() {
+  if (!DebugSerialEnabled()) return;
+
+#if LED_STATS
+  const auto& stats = LED::STATS::GetStats();
+  const double cyclesPerUs = static_cast<double>(LED::STATS::CyclesPerMicrosecond());
+
+  PrintResponseLineFmt("Frame statistics over the last %.1f s:",
+                       static_cast<double>(millis() - stats.sinceMs) * 0.001);
+  PrintResponseLine(F("  Stage         count     min us     avg us     p99 us     max us"));
+  for (uint8_t i = 0; i < LED::STATS::STAGE_COUNT; ++i) {
+    const auto& h = stats.stage[i];
+    if (h.count == 0) continue;
+    PrintResponseLineFmt("  %-8s %10lu %10.1f %10.1f %10.1f %10.1f", LED::STATS::kStageNames[i],
+                         static_cast<unsigned long>(h.count),
+                         h.minValue / cyclesPerUs, h.Average() / cyclesPerUs,
+                         h.Percentile(990) / cyclesPerUs, h.maxValue / cyclesPerUs);
+  }
+
+  const auto& late = stats.lateness;
+  if (late.count > 0) {
+    PrintResponseLineFmt("  Lateness %10lu %7lu ms %7lu ms %7lu ms %7lu ms", static_cast<unsigned long>(late.count),
+                         static_cast<unsigned long>(late.minValue), static_cast<unsigned long>(late.Average()),
+                         static_cast<unsigned long>(late.Percentile(990)), static_cast<unsigned long>(late.maxValue));
+  }
+  PrintResponseLineFmt("  Missed deadlines: %lu", static_cast<unsigned long>(stats.missedDeadlines));
+#else
+  PrintResponseLine(F("STATS: frame statistics are compiled out (LED_STATS 0)."));
+#endif
+}
+
+
 /* ------------------ System helper utilities --------------------------- */
 
 inline void ScheduleSystemRestart(uint32_t delayMs) {
@@ -27,6 +27,7 @@
 
 #include <Arduino.h>
 #include <Preferences.h>
+#include "060_TRACE.h"
 
 #ifndef CONFIG_VERSION
 #error "CONFIG_VERSION must be defined before including 300_SETTINGS.h, e.g. #define CONFIG_VERSION \"V01.01.04\""
@@ -214,10 +215,14 @@ inline bool SaveStructPref(const char* key, const T& obj) {
   uint16_t csum = simpleChecksum(reinterpret_cast<const uint8_t*>(&obj), payloadLen);
   memcpy(cur, &csum, sizeof(uint16_t));
 
-  Preferences pref;
-  pref.begin(kPrefsNamespace, false); // read/write
-  bool ok = pref.putBytes(key, g_blobBuffer, total);
-  pref.end();
+  bool ok;
+  {
+    TRACE::Scope trace(TRACE::SETTINGS_SAVE);
+    Preferences pref;
+    pref.begin(kPrefsNamespace, false); // read/write
+    ok = pref.putBytes(key, g_blobBuffer, total);
+    pref.end();
+  }
 
   if (!ok && DEBUG_SERIAL) {
     Serial.println(F("SaveStructPref: pref.putBytes failed"));
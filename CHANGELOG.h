@@ -1,3 +1,127 @@
+V01.03.38
+// Fixed-point Colors[] truncation gets a 2^-12 slack (FIXED::kTruncationSlack): blends that are exactly a whole code no longer drop one, fixed variants now stay within 1 LSB. verify tolerance back to 1 (2 only for the wide variants).
+// SET PARAM 16 rejects 0; a stored effectStepsPerSecond of 0 resets the scale at once when the effect is off, so the loop can still park. bench_core --tick-check (run by make verify) checks Fade()/EFFECTS::Run() at 1/4/10/25 ms ticks.
+// LED_CORE_DITHER: once fades and effect have settled (plus LED_CORE_DITHER_SETTLE_MS, default 0) the output stage rounds plainly, so a static colour with fractions no longer keeps the loop rendering every 4 ms; it parks like an undithered build.
+// loop() runs LED::Update(), SETTINGS::Update() and CONSOLE::Process() again after homeSpan.poll(): since V01.03.37 removed the WS2801 demo writes from DEV_Color1_Light, nothing else drove the strip after setup().
+// Host: the simulator runs only the sketch's setup()/loop() instead of adding its own LED::Update()/SETTINGS::Update()/CONSOLE::Process() calls.
+// Host: trace lines EXPECT IDLE|AWAKE check LED::IsIdle() (exit 1 on failure); make verify replays traces/idle_park.trace (park after fades, wake on HomeKit/console writes) on the plain and the dithered simulator.
+// Transmitter Configure() returns bool; RmtTransmitter checks rmt_config()/rmt_driver_install()/rmt_translator_init() and InitLedHardware() passes the result on. RmtTransmitter (legacy driver/rmt.h) is only compiled for async builds on arduino-esp32 < 3; async WS2812 on 3.x is an #error.
+// NOISE takes its time from EFFECTS::Engine::runMs (elapsed time handed to EFFECTS::Run() since the kernel started) instead of millis(), like every other transition.
+// Host: bench_core --tick-check also fails if an effect did not move during the simulated second; the NOISE rows are now deterministic.
+// Blocking WS2801 show no longer spins through the 500 us latch after every frame: SpiTransmitter::kSentOnStart lets Present() return once the bytes are out, the next Present() waits for the latch if it is still running.
+// ShowStats::waits/waitUs/maxWaitUs count only waits for a transmitter still busy with the previous frame; a blocking show's wait for its own frame goes to the new ShowStats::sendUs.
+// Console commands no longer wake the LED loop unconditionally; only state changes do (through MarkChangeInConfig()), so HELP/STATS/TRACE leave a parked lamp parked. idle_park.trace checks it.
+
+V01.03.37
+// HAL_CONFIG_SINGLE_WS2801 drives the strip: SpiTransmitter clocks the packed frame out as one hardware SPI transaction per frame (HAL_SINGLE_WS2801_CLOCK_HZ, default 8 MHz, 500 us latch).
+// DEV_Color1_Light no longer drives its own WS2801_LED (removed the pulse demo loop); it only updates the mirror like Color 2. NullTransmitter removed.
+// Host: SPI.h mock records every transaction; the simulator checks each output frame against the SPI byte stream.
+
+V01.03.36
+// Added 055_HAL_SHOW.h and HAL_ASYNC_SHOW: FrameBuffers<Transmitter> double-buffers the wire frame; ShowLedHardware() swaps, starts the front buffer in the background and returns.
+// HAL::IsShowComplete()/GetShowStats() per profile. Transmitters: RmtTransmitter (ESP32, single WS2812), MockTransmitter (host, simulated bit time + latch, torn-frame check), NullTransmitter.
+// LED::ShowFrame() re-attaches wire-output builds to the new back buffer. Host: delayMicroseconds(); the simulator reports show stats.
+
+V01.03.35
+// Added 045_PIXEL_FORMAT.h: PIXEL::Format<Order, White> encodes a pixel with compile-time color order (RGB, GRB, BRG, RGBW, GRBW, WRGB) and white handling (Native, MixIntoRgb, Drop).
+// Every HAL profile defines HAL::Format from HAL_<PROFILE>_ORDER / _WHITE; SetPixelColor()/WriteFrame() encode through it (no more Color(g, r, b, w) packing). WS2812 defaults GRBW, WS2801 RGB + MixIntoRgb.
+// LED_CORE_WIRE_OUTPUT: the output stage stores through the same Format (CORE::StorePixel, WireBuffer::Store), so white mixing happens in the render pass.
+
+V01.03.34
+// Added LED_CORE_WIRE_OUTPUT: Vars::Pixels becomes a WireBuffer view onto the driver's transmit buffer(s) in the profile's wire order (HAL::kWireLayout, HAL::GetFrameBuffer()).
+// The output stage writes wire bytes directly; UpdateColor() only shows. WS2801 single keeps a packed RGB frame (HAL::g_frame). Default builds unchanged.
+// Host: new bench variants wire, fused-fixed-wire.
+
+V01.03.33
+// Added HAL::WriteFrame(pixels, count) per profile: NeoPixel profiles copy the whole frame into the driver buffer in one loop (offsets from the NEO_* type, same bytes as SetPixelColor()).
+// LED::UpdateColor() pushes each frame with one WriteFrame() + ShowLedHardware() call; SetPixelColor() stays as the per-pixel fallback for LED_CORE_SOA builds.
+
+V01.03.32
+// Added LED_CORE_WIDE_COLORS: gradient colors stay Q8.8 (Colors[] as uint16_t, RenderGradient emits ColorSample) instead of being truncated to 8 bit before scaling.
+// The output stage is the only quantization (ChannelScaler::Scaled() takes either depth; lut builds interpolate between table entries). Default builds unchanged.
+// Host: new bench variants wide, fixed-wide, fused-fixed-wide, fixed-wide-dither.
+
+V01.03.31
+// Added LED_CORE_DITHER: the output stage keeps Q8.8 and each pixel carries its rounding error to the next frame (first-order sigma-delta); lut builds use 16-bit gamma tables.
+// While a frame leaves fractions, LED::Update() keeps rendering every LED_CORE_DITHER_INTERVAL_MS (default 4 ms) instead of parking.
+// Host: new bench variants dither, fixed-dither, lut-dither.
+
+V01.03.30
+// Added host/simulator.cpp: the whole sketch on a virtual clock (host shims for Arduino/Serial/String, Preferences, HomeSpan, SPI) replaying HomeKit and console traces.
+// Reports per input the first frame, time and frames until the fades settle and when the loop parks; --frames/--trace-json dump every output frame and the event trace.
+// LED::OutputObserver() sees every frame UpdateColor() pushes. STATS stage OUTPUT renamed SHOW (clashed with Arduino's OUTPUT macro).
+
+V01.03.29
+// Added 060_TRACE.h: fixed ring of timed scopes (TRACE_CAPACITY, TRACE_EVENTS 0 compiles it out) exported as Chrome/Perfetto trace JSON.
+// Traced: LED::Update frame and effect ticks, Preferences writes, console commands, MAIN::MirrorUpdated and the HomeSpan update() callbacks.
+// New console commands TRACE (dump over serial) and TRACE CLEAR; host builds write the JSON with TRACE::WriteJsonFile().
+
+V01.03.28
+// Added 240_LED_STATS.h: LED::Update() times Fade, Gradient, Scaling (Render when fused), Output, Effect and the whole frame with the CPU cycle counter into log2 histograms.
+// Processing tick lateness against processingIntervalMs and missed deadlines are counted too. New console commands STATS / STATS RESET (HELP STATS); LED_STATS 0 compiles it out.
+
+V01.03.27
+// Idle parking: once fades reached their staging values and the effect is off and settled, LED::Update() sets State::idle and returns immediately.
+// Any MarkChangeInConfig()/MarkRenderDirty() or LED::Wake() (console commands) resumes with fresh timestamps; LED::IsIdle() lets the loop sleep.
+
+V01.03.26
+// Fades and effects integrate the elapsed time: CORE::Fade(elapsedMs), EFFECTS::Run(elapsedMs); tick rate or dropped frames no longer change transition speed.
+// Config colorIncrement/brightnessIncrement/onoffIncrement -> colorFadePerSecond/brightnessFadePerSecond/onoffFadePerSecond; new effectStepsPerSecond (SET PARAM 16). CONFIG_VERSION V01.14.
+
+V01.03.25
+// Added NOISE effect: fixed-point 2D value noise f(pixel, time) rendered straight into the scale windows (no shifting), drift speed in cells/s independent of effectIntervalMs.
+// New Config::effectNoiseScale / effectNoiseSpeed (SET PARAM 14/15). CONFIG_VERSION V01.13.
+// Effect kernels can now render whole windows (EffectKernel::render, ScaleRing::Overwrite/Mirror).
+
+V01.03.24
+// Added 230_LED_EFFECTS.h: effect kernels registered in EFFECTS::kEffects (name, channel mask, Reset/Step), stepped by EFFECTS::Run(); CORE::Effect moved there as RANDOM_WALK.
+// Config::effectIndex selects the kernel (SET EFFECT <name>, HELP SET EFFECT). CONFIG_VERSION V01.12.
+// With the effect off every channel (not just channel 0) returns to 1.0, then the tick stops touching Scale.
+
+V01.03.23
+// CORE::Effect draws from a per-lamp xorshift32 generator (Vars::Rng) instead of rand()/random(); same seed, same effect.
+// New Config::effectSeed (SET PARAM 13, 0 = random at startup); setting it restarts the effect. CONFIG_VERSION V01.11.
+
+V01.03.22
+// Gradient table builders are templates on GradientMode x InterpolationMode, picked through a function table on rebuild; region boundaries are found up front so the weight loops are branch-free.
+// Output unchanged (bit-identical on every host variant).
+
+V01.03.21
+// 220_GAMMA_TABLES.h is now a constexpr generator (GAMMA::MakeCurve/MakeGammaLut8/MakeGammaLut16/MakeChannelGammaLut8/16); the named gammaLut8_* tables are generated and identical to the pasted ones.
+// LUT output stage uses per-channel curves (LED_CORE_GAMMA, LED_CORE_GAMMA_R/G/B/W); MapCubic100to255 reads a compile-time table.
+
+V01.03.20
+// Added LED_CORE_OUTPUT_LUT output stage: one 256-entry table gamma(x * brightness/255 * onoffFactor) in Vars::Output, rebuilt only when brightness/onoff change.
+// The gamma curve is LED_CORE_GAMMA_TABLE from 220_GAMMA_TABLES.h (default gammaLut8_220), interpolated between entries.
+
+V01.03.19
+// Added State::renderDirty: LED::Update only renders and calls UpdateColor() when Fade() moved, the effect changed a scale, or the config changed.
+// ScaleRing pushes report whether the window changed, so a disabled effect settles instead of dirtying every tick.
+
+V01.03.18
+// Vars::Scale is now a ScaleRing: one mirrored ring buffer per channel with a head offset, so ShiftScaleChannel is O(1).
+// Output stages read each channel's scales through the contiguous Scale.Window(channel); Pixel_scale was removed.
+
+V01.03.17
+// Added Vars::Gradient weight table (spans + per-pixel weights), rebuilt by UpdateGradientTable() only when Count, mode or gradient* config changes.
+// RenderGradient now only fills solid spans and blends a + (b - a) * Weight[i]; output is unchanged in every pipeline variant.
+
+V01.03.16
+// Added CORE::RenderFrame() and LED_CORE_FUSED single-pass gradient/scale/brightness kernel that writes Pixels[] directly and drops Colors[].
+// ComputeGradient is now RenderGradient() with a per-pixel sink; the output math lives in ChannelScaler. LED::Update calls RenderFrame().
+
+V01.03.15
+// Added LED_CORE_SOA planar layout for Vars::Pixels/Colors/Scale (PlanarBuffer + Pixel_ref proxy); AoS stays the default.
+// Output scaling now goes through ScaleColorsIntoPixels(); ShiftScaleChannel moves a whole plane with memmove in the SoA build.
+
+V01.03.14
+// Added LED_CORE_FIXED_POINT integer pipeline for ComputeGradient/ApplyOutputScaling; Scale[] now stores ScaleSample (Q4.12 when fixed).
+// Added make -C host verify: float vs. fixed reference scenes agree within 1 LSB except at float rounding ties amplified by effect scale (max 2 LSB).
+
+V01.03.13
+// Added host/ build of LED::CORE with an Arduino shim and a kernel microbenchmark (make -C host bench).
+// Widened Config::count to uint16_t so LED_COUNT above 255 builds; bumped CONFIG_VERSION to V01.10.
+
 V01.03.12
 // Removed unused CONSOLE configuration persistence and bumped CONFIG_VERSION to V01.09.
 // Removed unused SYSTEM LED_COUNT/CONFIRM console paths and kept SYSTEM RESET restart handling.
@@ -16,8 +16,8 @@
 #define DEBUG_SERIAL true
 
 // defines for device identification
-#define SKETCH_VERSION "V01.03.12"
-#define CONFIG_VERSION "V01.09"
+#define SKETCH_VERSION "V01.03.38"
+#define CONFIG_VERSION "V01.14"
 
 
 
@@ -30,7 +30,10 @@
 
 
 ////////// Header Files //////////
+#include "045_PIXEL_FORMAT.h"
 #include "050_HAL.h"
+#include "055_HAL_SHOW.h"
+#include "060_TRACE.h"
 #include "100_DEVICE_LINKER.h"
 #include "200_LED_LINKER.h"
 //#include "220_GAMMA_TABLES.h"
@@ -95,6 +98,7 @@ void setup() {
 
   if (!LED::Init()) {
     // handle error
+    if (DEBUG_SERIAL) Serial.println("   LED hardware init failed");
   }
 
   SETTINGS::InitAndLoadReport();
@@ -116,12 +120,12 @@ void loop() {
 
   homeSpan.poll();
 
-  //LED::Update();
+  LED::Update();
 
-  //MAIN::UpdateDeviceBridge();
+  MAIN::UpdateDeviceBridge();
 
-  //SETTINGS::Update();
+  SETTINGS::Update();
 
-  //CONSOLE::Process();
+  CONSOLE::Process();
 
 }
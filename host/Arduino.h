@@ -0,0 +1,249 @@
+//////////////////////////////////
+//      HOST ARDUINO SHIM       //
+//////////////////////////////////
+/**
+ * @file Arduino.h
+ * @brief Minimal stand-in for <Arduino.h> so the LED core builds on a host PC.
+ *
+ * Only what the header-only modules actually touch is provided:
+ *  - millis()/micros()/delay()/delayMicroseconds() on top of
+ *    std::chrono::steady_clock, or on a virtual clock that only moves through
+ *    HOST::AdvanceMicros() and the delays (HOST::UseVirtualClock(), used by
+ *    the simulator)
+ *  - random(max)/random(min, max) with Arduino semantics (upper bound exclusive)
+ *  - constrain(), min(), max()
+ *  - F()/String/Serial/ESP and the pin functions the sketch headers call, so the
+ *    whole sketch compiles for the simulator; Serial output goes to
+ *    HOST::SerialOut() (nullptr = discarded) and input comes from HOST::SerialIn()
+ *
+ * The host Makefile puts this directory first on the include path, so
+ * `#include <Arduino.h>` inside the sketch headers resolves to this file.
+ */
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+#include <ctype.h>
+#include <stdarg.h>
+#include <stdio.h>
+#include <strings.h>
+
+#include <algorithm>
+#include <chrono>
+#include <deque>
+#include <string>
+#include <thread>
+#include <type_traits>
+
+using std::max;
+using std::min;
+
+#ifndef constrain
+#define constrain(amt, low, high) ((amt) < (low) ? (low) : ((amt) > (high) ? (high) : (amt)))
+#endif
+
+namespace HOST {
+
+/**
+ * @brief Time origin shared by millis()/micros(), taken on first use.
+ */
+inline std::chrono::steady_clock::time_point& ClockOrigin() {
+  static std::chrono::steady_clock::time_point origin = std::chrono::steady_clock::now();
+  return origin;
+}
+
+/**
+ * @brief Virtual time base: while `enabled`, millis()/micros() return `nowUs`.
+ */
+struct VirtualClock {
+  bool enabled = false;
+  uint64_t nowUs = 0;
+};
+
+inline VirtualClock& GetVirtualClock() {
+  static VirtualClock clock;
+  return clock;
+}
+
+inline void UseVirtualClock(bool enabled, uint64_t startUs = 0) {
+  GetVirtualClock().enabled = enabled;
+  GetVirtualClock().nowUs = startUs;
+}
+
+inline void AdvanceMicros(uint64_t us) { GetVirtualClock().nowUs += us; }
+
+inline uint64_t ElapsedMicros() {
+  if (GetVirtualClock().enabled) return GetVirtualClock().nowUs;
+  const auto now = std::chrono::steady_clock::now();
+  return static_cast<uint64_t>(
+      std::chrono::duration_cast<std::chrono::microseconds>(now - ClockOrigin()).count());
+}
+
+inline FILE*& SerialOut() {
+  static FILE* out = nullptr;
+  return out;
+}
+
+inline std::deque<char>& SerialIn() {
+  static std::deque<char> in;
+  return in;
+}
+
+inline bool& RestartRequested() {
+  static bool requested = false;
+  return requested;
+}
+
+}  // namespace HOST
+
+inline uint32_t millis() { return static_cast<uint32_t>(HOST::ElapsedMicros() / 1000u); }
+
+inline uint32_t micros() { return static_cast<uint32_t>(HOST::ElapsedMicros()); }
+
+inline void delay(uint32_t ms) {
+  if (HOST::GetVirtualClock().enabled) {
+    HOST::AdvanceMicros(static_cast<uint64_t>(ms) * 1000u);
+    return;
+  }
+  std::this_thread::sleep_for(std::chrono::milliseconds(ms));
+}
+
+inline void delayMicroseconds(uint32_t us) {
+  if (HOST::GetVirtualClock().enabled) {
+    HOST::AdvanceMicros(us);
+    return;
+  }
+  std::this_thread::sleep_for(std::chrono::microseconds(us));
+}
+
+inline long random(long howbig) {
+  if (howbig <= 0) return 0;
+  return static_cast<long>(rand() % howbig);
+}
+
+inline long random(long howsmall, long howbig) {
+  if (howsmall >= howbig) return howsmall;
+  return howsmall + random(howbig - howsmall);
+}
+
+inline void randomSeed(unsigned long seed) { srand(static_cast<unsigned int>(seed)); }
+
+
+typedef bool boolean;
+
+#define DEC 10
+#define HEX 16
+
+#define LOW 0
+#define HIGH 1
+#define INPUT 0
+#define OUTPUT 1
+
+inline void pinMode(uint8_t, uint8_t) {}
+inline void digitalWrite(uint8_t, uint8_t) {}
+
+
+
+class __FlashStringHelper;
+#define F(string_literal) (reinterpret_cast<const __FlashStringHelper*>(string_literal))
+
+/**
+ * @brief Just enough of Arduino's String for message building.
+ */
+class String {
+ public:
+  String() = default;
+  String(const char* text) : text_(text ? text : "") {}
+  String(const __FlashStringHelper* text) : String(reinterpret_cast<const char*>(text)) {}
+  template<typename T, typename = typename std::enable_if<std::is_arithmetic<T>::value>::type>
+  explicit String(T value) : text_(std::to_string(value)) {}
+
+  String& operator+=(const String& other) { text_ += other.text_; return *this; }
+  String& operator+=(const char* text) { text_ += (text ? text : ""); return *this; }
+  String& operator+=(char c) { text_ += c; return *this; }
+  template<typename T, typename = typename std::enable_if<std::is_arithmetic<T>::value>::type>
+  String& operator+=(T value) { text_ += std::to_string(value); return *this; }
+
+  const char* c_str() const { return text_.c_str(); }
+  size_t length() const { return text_.size(); }
+
+ private:
+  std::string text_;
+};
+
+
+
+/**
+ * @brief Serial stand-in: writes to HOST::SerialOut(), reads HOST::SerialIn().
+ */
+class HostSerial {
+ public:
+  void begin(unsigned long) {}
+  explicit operator bool() const { return true; }
+
+  int available() const { return static_cast<int>(HOST::SerialIn().size()); }
+  int read() {
+    auto &in = HOST::SerialIn();
+    if (in.empty()) return -1;
+    const char c = in.front();
+    in.pop_front();
+    return static_cast<unsigned char>(c);
+  }
+
+  size_t print(const char* text) { return Write(text ? text : ""); }
+  size_t print(const __FlashStringHelper* text) { return print(reinterpret_cast<const char*>(text)); }
+  size_t print(const String& text) { return Write(text.c_str()); }
+  size_t print(char c) { const char text[2] = { c, '\0' }; return Write(text); }
+  size_t print(double value, int digits = 2) { return Printf("%.*f", digits, value); }
+  template<typename T, typename = typename std::enable_if<std::is_integral<T>::value>::type>
+  size_t print(T value, int base = DEC) {
+    if (base == HEX) return Printf("%llX", static_cast<unsigned long long>(value));
+    return std::is_signed<T>::value ? Printf("%lld", static_cast<long long>(value))
+                                    : Printf("%llu", static_cast<unsigned long long>(value));
+  }
+
+  size_t println() { return Write("\n"); }
+  template<typename T>
+  size_t println(const T& value) { return print(value) + println(); }
+  size_t println(double value, int digits) { return print(value, digits) + println(); }
+
+  size_t printf(const char* fmt, ...) {
+    char buf[256];
+    va_list ap;
+    va_start(ap, fmt);
+    vsnprintf(buf, sizeof(buf), fmt, ap);
+    va_end(ap);
+    return Write(buf);
+  }
+
+ private:
+  size_t Write(const char* text) {
+    if (HOST::SerialOut()) fputs(text, HOST::SerialOut());
+    return strlen(text);
+  }
+
+  template<typename... Args>
+  size_t Printf(const char* fmt, Args... args) {
+    char buf[64];
+    snprintf(buf, sizeof(buf), fmt, args...);
+    return Write(buf);
+  }
+};
+
+inline HostSerial Serial;
+
+
+
+/**
+ * @brief ESP stand-in: restart() only raises HOST::RestartRequested().
+ */
+struct HostEsp {
+  void restart() { HOST::RestartRequested() = true; }
+};
+
+inline HostEsp ESP;
@@ -0,0 +1,215 @@
+//////////////////////////////////
+//     HOST HOMESPAN SHIM       //
+//////////////////////////////////
+/**
+ * @file HomeSpan.h
+ * @brief Stand-in for the parts of HomeSpan that 110_DEVICE.h uses.
+ *
+ * Services register themselves in HOST::GetServices() when constructed and
+ * collect the characteristics created after them, like HomeSpan does. A
+ * HomeKit write is queued with HOST::QueueWrite(). The next homeSpan.poll()
+ * delivers the queued writes of each service as one update() call: it sets
+ * getNewVal() and then commits the values if update() returned true. Then it
+ * runs every service's loop(). No networking, pairing or NVS restore.
+ */
+
+#pragma once
+
+#include <Arduino.h>
+
+#include <vector>
+
+enum class Category { Lighting };
+
+class SpanService;
+
+/**
+ * @brief One characteristic: committed value, pending new value and range.
+ */
+class SpanCharacteristic {
+ public:
+  SpanCharacteristic(const char* type, double value);
+  SpanCharacteristic(const char* type, const char* text);
+
+  template<typename T = int>
+  T getVal() const { return static_cast<T>(value_); }
+
+  template<typename T = int>
+  T getNewVal() const { return static_cast<T>(updated_ ? newValue_ : value_); }
+
+  bool updated() const { return updated_; }
+
+  template<typename T>
+  void setVal(T value) { value_ = Clamp(static_cast<double>(value)); }
+
+  SpanCharacteristic* setRange(double minValue, double maxValue, double step = 0) {
+    min_ = minValue;
+    max_ = maxValue;
+    (void)step;
+    return this;
+  }
+
+  const char* type() const { return type_; }
+
+  // simulator side: stage a HomeKit write, then commit or drop it after update()
+  void Stage(double value) {
+    newValue_ = Clamp(value);
+    updated_ = true;
+  }
+
+  void Finish(bool commit) {
+    if (commit && updated_) value_ = newValue_;
+    updated_ = false;
+  }
+
+ private:
+  double Clamp(double value) const { return value < min_ ? min_ : (value > max_ ? max_ : value); }
+
+  const char* type_;
+  double value_ = 0;
+  double newValue_ = 0;
+  double min_ = -1e9;
+  double max_ = 1e9;
+  bool updated_ = false;
+};
+
+namespace HOST {
+
+struct PendingWrite {
+  SpanService* service;
+  SpanCharacteristic* characteristic;
+  double value;
+};
+
+inline std::vector<SpanService*>& GetServices() {
+  static std::vector<SpanService*> services;
+  return services;
+}
+
+inline std::vector<PendingWrite>& GetPendingWrites() {
+  static std::vector<PendingWrite> writes;
+  return writes;
+}
+
+}  // namespace HOST
+
+class SpanService {
+ public:
+  explicit SpanService(const char* type) : type_(type) { HOST::GetServices().push_back(this); }
+  virtual ~SpanService() = default;
+
+  virtual boolean update() { return true; }
+  virtual void loop() {}
+
+  const char* type() const { return type_; }
+  std::vector<SpanCharacteristic*>& characteristics() { return characteristics_; }
+
+  SpanCharacteristic* Find(const char* characteristicType) {
+    for (SpanCharacteristic *c : characteristics_) {
+      if (strcasecmp(c->type(), characteristicType) == 0) return c;
+    }
+    return nullptr;
+  }
+
+ private:
+  const char* type_;
+  std::vector<SpanCharacteristic*> characteristics_;
+};
+
+inline SpanCharacteristic::SpanCharacteristic(const char* type, double value) : type_(type), value_(value) {
+  if (!HOST::GetServices().empty()) HOST::GetServices().back()->characteristics().push_back(this);
+}
+
+inline SpanCharacteristic::SpanCharacteristic(const char* type, const char* text) : type_(type) {
+  (void)text;
+  if (!HOST::GetServices().empty()) HOST::GetServices().back()->characteristics().push_back(this);
+}
+
+struct SpanAccessory {
+  SpanAccessory() {}
+};
+
+namespace Service {
+struct AccessoryInformation : SpanService { AccessoryInformation() : SpanService("AccessoryInformation") {} };
+struct HAPProtocolInformation : SpanService { HAPProtocolInformation() : SpanService("HAPProtocolInformation") {} };
+struct LightBulb : SpanService { LightBulb() : SpanService("LightBulb") {} };
+}  // namespace Service
+
+namespace Characteristic {
+#define HOST_SPAN_NUMERIC(NAME, DEFAULT) \
+  struct NAME : SpanCharacteristic { explicit NAME(double value = DEFAULT, bool nvsStore = false) : SpanCharacteristic(#NAME, value) { (void)nvsStore; } };
+#define HOST_SPAN_TEXT(NAME) \
+  struct NAME : SpanCharacteristic { explicit NAME(const char* text = "") : SpanCharacteristic(#NAME, text) {} };
+
+HOST_SPAN_NUMERIC(On, 0)
+HOST_SPAN_NUMERIC(Hue, 0)
+HOST_SPAN_NUMERIC(Saturation, 0)
+HOST_SPAN_NUMERIC(Brightness, 100)
+HOST_SPAN_NUMERIC(Identify, 0)
+HOST_SPAN_TEXT(Name)
+HOST_SPAN_TEXT(Manufacturer)
+HOST_SPAN_TEXT(SerialNumber)
+HOST_SPAN_TEXT(Model)
+HOST_SPAN_TEXT(FirmwareRevision)
+HOST_SPAN_TEXT(Version)
+
+#undef HOST_SPAN_NUMERIC
+#undef HOST_SPAN_TEXT
+}  // namespace Characteristic
+
+namespace HOST {
+
+/**
+ * @brief The `index`-th (0-based) registered service of `type`, or nullptr.
+ */
+inline SpanService* FindService(const char* type, size_t index) {
+  for (SpanService *s : GetServices()) {
+    if (strcasecmp(s->type(), type) != 0) continue;
+    if (index == 0) return s;
+    --index;
+  }
+  return nullptr;
+}
+
+/**
+ * @brief Queue a HomeKit write; false if the service has no such characteristic.
+ */
+inline bool QueueWrite(SpanService* service, const char* characteristicType, double value) {
+  if (!service) return false;
+  SpanCharacteristic *c = service->Find(characteristicType);
+  if (!c) return false;
+  GetPendingWrites().push_back(PendingWrite{ service, c, value });
+  return true;
+}
+
+}  // namespace HOST
+
+class Span {
+ public:
+  void begin(Category, const char* name) { (void)name; }
+  void setSketchVersion(const char* version) { (void)version; }
+  int getStatusPin() const { return 0; }
+
+  void poll() {
+    DeliverWrites();
+    for (SpanService *s : HOST::GetServices()) s->loop();
+  }
+
+ private:
+  void DeliverWrites() {
+    auto &writes = HOST::GetPendingWrites();
+    while (!writes.empty()) {
+      SpanService *service = writes.front().service;
+      for (auto it = writes.begin(); it != writes.end();) {
+        if (it->service != service) { ++it; continue; }
+        it->characteristic->Stage(it->value);
+        it = writes.erase(it);
+      }
+      const bool ok = service->update();
+      for (SpanCharacteristic *c : service->characteristics()) c->Finish(ok);
+    }
+  }
+};
+
+inline Span homeSpan;
+
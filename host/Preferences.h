@@ -0,0 +1,92 @@
+//////////////////////////////////
+//    HOST PREFERENCES SHIM     //
+//////////////////////////////////
+/**
+ * @file Preferences.h
+ * @brief In-memory stand-in for the ESP32 Preferences (NVS) API.
+ *
+ * Namespaces and keys live in HOST::GetNvs() for the lifetime of the process,
+ * so a simulated reboot sees what was saved before it. Every successful
+ * putBytes() is appended to HOST::GetNvsWrites() with the millis() it happened
+ * at, which is how the simulator reports settings writes.
+ */
+
+#pragma once
+
+#include <Arduino.h>
+
+#include <map>
+#include <string>
+#include <vector>
+
+namespace HOST {
+
+struct NvsWrite {
+  uint32_t timeMs;
+  std::string key;  ///< "namespace/key"
+  size_t length;
+};
+
+inline std::map<std::string, std::vector<uint8_t>>& GetNvs() {
+  static std::map<std::string, std::vector<uint8_t>> nvs;
+  return nvs;
+}
+
+inline std::vector<NvsWrite>& GetNvsWrites() {
+  static std::vector<NvsWrite> writes;
+  return writes;
+}
+
+}  // namespace HOST
+
+class Preferences {
+ public:
+  bool begin(const char* name, bool readOnly = false) {
+    namespace_ = name ? name : "";
+    readOnly_ = readOnly;
+    open_ = true;
+    return true;
+  }
+
+  void end() { open_ = false; }
+
+  size_t putBytes(const char* key, const void* value, size_t len) {
+    if (!open_ || readOnly_ || !key) return 0;
+    const uint8_t* bytes = static_cast<const uint8_t*>(value);
+    HOST::GetNvs()[Path(key)].assign(bytes, bytes + len);
+    HOST::GetNvsWrites().push_back(HOST::NvsWrite{ millis(), Path(key), len });
+    return len;
+  }
+
+  size_t getBytesLength(const char* key) {
+    const auto *entry = Find(key);
+    return entry ? entry->size() : 0;
+  }
+
+  size_t getBytes(const char* key, void* buf, size_t maxLen) {
+    const auto *entry = Find(key);
+    if (!entry || entry->size() > maxLen) return 0;
+    memcpy(buf, entry->data(), entry->size());
+    return entry->size();
+  }
+
+  bool isKey(const char* key) { return Find(key) != nullptr; }
+
+  bool remove(const char* key) {
+    if (!open_ || readOnly_ || !key) return false;
+    return HOST::GetNvs().erase(Path(key)) > 0;
+  }
+
+ private:
+  std::string Path(const char* key) const { return namespace_ + "/" + key; }
+
+  const std::vector<uint8_t>* Find(const char* key) const {
+    if (!open_ || !key) return nullptr;
+    const auto it = HOST::GetNvs().find(Path(key));
+    return (it == HOST::GetNvs().end()) ? nullptr : &it->second;
+  }
+
+  std::string namespace_;
+  bool readOnly_ = true;
+  bool open_ = false;
+};
@@ -0,0 +1,97 @@
+//////////////////////////////////
+//        HOST SPI SHIM         //
+//////////////////////////////////
+/**
+ * @file SPI.h
+ * @brief Mock of the Arduino-ESP32 SPIClass that records every byte written.
+ *
+ * Each beginTransaction() opens a new entry in HOST::GetSpiBus().transactions
+ * and writeBytes()/transfer() append to it, so a test or the simulator can
+ * compare what a HAL profile put on the wire with the frames the LED core
+ * produced. On the virtual clock a write takes bytes * 8 / clock of simulated
+ * time, like the blocking hardware transfer.
+ */
+
+#pragma once
+
+#include <Arduino.h>
+
+#include <vector>
+
+#define MSBFIRST 1
+#define LSBFIRST 0
+#define SPI_MODE0 0
+#define SPI_MODE1 1
+#define SPI_MODE2 2
+#define SPI_MODE3 3
+
+namespace HOST {
+
+/**
+ * @brief What the sketch did with the SPI bus.
+ */
+struct SpiBus {
+  int8_t sck = -1, miso = -1, mosi = -1, ss = -1;  ///< pins passed to begin()
+  bool begun = false;
+  uint32_t clockHz = 1000000;  ///< clock of the current/last transaction
+  uint8_t dataMode = SPI_MODE0;
+  std::vector<std::vector<uint8_t>> transactions;  ///< bytes written, one entry per transaction
+  uint64_t bytes = 0;                              ///< total bytes written
+};
+
+inline SpiBus& GetSpiBus() {
+  static SpiBus bus;
+  return bus;
+}
+
+}  // namespace HOST
+
+class SPISettings {
+ public:
+  SPISettings(uint32_t clockHz = 1000000, uint8_t bitOrder = MSBFIRST, uint8_t dataMode = SPI_MODE0)
+      : clockHz(clockHz), bitOrder(bitOrder), dataMode(dataMode) {}
+
+  uint32_t clockHz;
+  uint8_t bitOrder;
+  uint8_t dataMode;
+};
+
+class SPIClass {
+ public:
+  void begin(int8_t sck = -1, int8_t miso = -1, int8_t mosi = -1, int8_t ss = -1) {
+    HOST::SpiBus &bus = HOST::GetSpiBus();
+    bus.sck = sck;
+    bus.miso = miso;
+    bus.mosi = mosi;
+    bus.ss = ss;
+    bus.begun = true;
+  }
+
+  void end() { HOST::GetSpiBus().begun = false; }
+
+  void beginTransaction(const SPISettings &settings) {
+    HOST::SpiBus &bus = HOST::GetSpiBus();
+    bus.clockHz = settings.clockHz;
+    bus.dataMode = settings.dataMode;
+    bus.transactions.emplace_back();
+  }
+
+  void endTransaction() {}
+
+  void writeBytes(const uint8_t *data, uint32_t size) {
+    HOST::SpiBus &bus = HOST::GetSpiBus();
+    if (bus.transactions.empty()) bus.transactions.emplace_back();
+    bus.transactions.back().insert(bus.transactions.back().end(), data, data + size);
+    bus.bytes += size;
+    if (HOST::GetVirtualClock().enabled && bus.clockHz > 0) {
+      HOST::AdvanceMicros(static_cast<uint64_t>(size) * 8u * 1000000u / bus.clockHz);
+    }
+  }
+
+  uint8_t transfer(uint8_t data) {
+    writeBytes(&data, 1);
+    return 0;
+  }
+};
+
+inline SPIClass SPI;
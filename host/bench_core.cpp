@@ -0,0 +1,440 @@
+//////////////////////////////////
+//   HOST CORE MICROBENCHMARK   //
+//////////////////////////////////
+/**
+ * @file bench_core.cpp
+ * @brief Host-side timing of the LED::CORE render kernels.
+ *
+ * Builds 210_LED_CORE.h and 230_LED_EFFECTS.h against the Arduino shim in this
+ * directory and reports ns/frame for the GradientTable rebuild and ComputeGradient
+ * (every GradientMode), ApplyOutputScaling, Fade, the effect tick (EFFECTS::Run),
+ * ShiftScaleChannel and the Fade + RenderFrame path that LED::Update() runs. LED_CORE_FUSED builds have no separate gradient/scaling kernels, so
+ * only the frame rows are comparable across all variants.
+ *
+ * The core is compiled once with a capacity of LED_COUNT pixels; the strip
+ * lengths in kCounts are swept at runtime through Vars::Count, exactly like a
+ * lamp whose HAL profile uses fewer pixels than the buffers can hold.
+ *
+ * Usage:
+ *   make bench            (table output)
+ *   ./build/bench_core --csv > bench_output.txt
+ *
+ * Pipeline comparison (e.g. float vs. LED_CORE_FIXED_POINT builds):
+ *   ./build/bench_core --dump frames.bin
+ *   ./build/bench_core_fixed --compare frames.bin
+ * renders a fixed set of scenes into Pixels[] and reports the per-channel
+ * differences; exits non-zero if any exceeds --tolerance (default 1 LSB).
+ *
+ * Tick-rate invariance:
+ *   ./build/bench_core --tick-check
+ * runs the same simulated second of Fade() + EFFECTS::Run() (every effect, and
+ * the slide back to 1.0 with the effect off) at several tick lengths and
+ * exits non-zero unless brightness, on/off, both colors and every Scale
+ * sample end up the same. Each effect must also have moved during that
+ * second, so a kernel that ignores the elapsed time cannot pass by standing
+ * still; the run uses only simulated time, never the host clock.
+ */
+
+#ifndef LED_COUNT
+#define LED_COUNT 1024
+#endif
+
+#include "../210_LED_CORE.h"
+#include "../230_LED_EFFECTS.h"
+
+#include <stdio.h>
+
+#include <algorithm>
+#include <chrono>
+#include <functional>
+#include <vector>
+
+namespace BENCH {
+
+namespace CORE = LED::CORE;
+namespace EFFECTS = LED::EFFECTS;
+
+constexpr size_t kCounts[] = { 31, 69, 138, 300, 1000 };
+
+constexpr CORE::GradientMode kModes[] = {
+  CORE::LINEAR,
+  CORE::LINEAR_PADDING,
+  CORE::SINGLE_COLOR,
+  CORE::MIDPOINT_SPLIT,
+  CORE::EDGE_CENTER,
+};
+
+// elapsed time handed to Fade()/EFFECTS::Run() per simulated frame (one effect step at 100 steps/s)
+constexpr uint32_t kTickMs = 10;
+
+constexpr int kRepetitions = 7;
+constexpr double kTargetRepNs = 5e6;  // aim for ~5 ms per repetition
+
+struct Result {
+  double minNs;
+  double medianNs;
+};
+
+static bool g_csv = false;
+
+#if LED_CORE_WIRE_OUTPUT
+// stands in for the driver's transmit buffer that LED::Init() attaches on the device
+static uint8_t g_wire[LED_COUNT * CORE::PixelBuffer::Stride];
+#endif
+
+/**
+ * @brief Compiler barrier so kernels writing into the Vars singleton are not elided.
+ */
+inline void Clobber() { asm volatile("" ::: "memory"); }
+
+inline const char* ModeName(CORE::GradientMode mode) {
+  switch (mode) {
+    case CORE::LINEAR: return "LINEAR";
+    case CORE::LINEAR_PADDING: return "LINEAR_PADDING";
+    case CORE::SINGLE_COLOR: return "SINGLE_COLOR";
+    case CORE::MIDPOINT_SPLIT: return "MIDPOINT_SPLIT";
+    case CORE::EDGE_CENTER: return "EDGE_CENTER";
+    default: return "UNKNOWN";
+  }
+}
+
+/**
+ * @brief Run `fn` in a calibrated loop and return min/median ns per call.
+ */
+template<typename Fn>
+Result Measure(Fn&& fn) {
+  using Clock = std::chrono::steady_clock;
+
+  auto runBatch = [&](uint32_t iterations) {
+    const auto start = Clock::now();
+    for (uint32_t i = 0; i < iterations; ++i) {
+      fn();
+      Clobber();
+    }
+    const auto stop = Clock::now();
+    return static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(stop - start).count());
+  };
+
+  uint32_t iterations = 1;
+  while (iterations < (1u << 30)) {
+    const double ns = runBatch(iterations);
+    if (ns >= kTargetRepNs) break;
+    iterations *= 2;
+  }
+
+  std::vector<double> samples;
+  samples.reserve(kRepetitions);
+  for (int rep = 0; rep < kRepetitions; ++rep) {
+    samples.push_back(runBatch(iterations) / static_cast<double>(iterations));
+  }
+  std::sort(samples.begin(), samples.end());
+
+  return { samples.front(), samples[samples.size() / 2] };
+}
+
+/**
+ * @brief Reset the core for `count` pixels and stage a representative frame:
+ *        two distinct colors mid-fade, partial brightness and a warmed-up effect.
+ */
+inline void PrepareFrame(size_t count) {
+  auto& v = CORE::GetVars();
+  auto& c = CORE::GetConfig();
+
+  srand(1);
+  v.Count = count;
+  CORE::Init();
+  EFFECTS::Init();
+
+  v.colorOne = { 200.0f, 40.0f, 10.0f, 30.0f };
+  v.colorTwo = { 10.0f, 90.0f, 220.0f, 5.0f };
+  v.brightness = 180.0f;
+  v.onoffFactor = 0.85f;
+
+  c.colorOneStaging = { 255.0f, 0.0f, 0.0f, 255.0f };
+  c.colorTwoStaging = { 0.0f, 255.0f, 0.0f, 0.0f };
+  c.brightnessStaging = 255.0f;
+  c.onoffStaging = 1.0f;
+  c.colorFadePerSecond = 0.1f;
+  c.brightnessFadePerSecond = 0.1f;
+  c.onoffFadePerSecond = 0.001f;
+  c.effectStepsPerSecond = 100.0f;
+  c.effectActive = true;
+  c.effectSeed = 1;
+
+  for (size_t i = 0; i < count; ++i) {
+    EFFECTS::Run(kTickMs);
+  }
+}
+
+inline void Report(const char* kernel, const char* mode, size_t count, const Result& r) {
+  const double perPixel = r.medianNs / static_cast<double>(count);
+  if (g_csv) {
+    printf("%s,%s,%zu,%.1f,%.1f,%.3f\n", kernel, mode, count, r.medianNs, r.minNs, perPixel);
+  } else {
+    printf("%-20s %-16s %6zu %12.1f %12.1f %10.3f\n", kernel, mode, count, r.medianNs, r.minNs, perPixel);
+  }
+}
+
+inline void PrintHeader() {
+  if (g_csv) {
+    printf("kernel,mode,count,ns_per_frame_median,ns_per_frame_min,ns_per_pixel\n");
+    return;
+  }
+  printf("LED::CORE host benchmark (capacity LED_COUNT=%zu, %d repetitions)\n",
+         static_cast<size_t>(CORE::Vars::Capacity), kRepetitions);
+  printf("%-20s %-16s %6s %12s %12s %10s\n", "kernel", "mode", "count", "ns/frame", "min ns", "ns/pixel");
+}
+
+inline void RunCount(size_t count) {
+  auto& c = CORE::GetConfig();
+
+  for (CORE::GradientMode mode : kModes) {
+    PrepareFrame(count);
+    auto& table = CORE::GetVars().Gradient;
+    Report("GradientTable", ModeName(mode), count, Measure([&] {
+             table.valid = false;
+             CORE::UpdateGradientTable(mode);
+           }));
+  }
+
+#if !LED_CORE_FUSED
+  for (CORE::GradientMode mode : kModes) {
+    PrepareFrame(count);
+    Report("ComputeGradient", ModeName(mode), count,
+           Measure([&] { CORE::ComputeGradient(mode, c.gradientInvertColors); }));
+  }
+
+  PrepareFrame(count);
+  CORE::ComputeGradient(c.gradientMode, c.gradientInvertColors);
+  Report("ApplyOutputScaling", "-", count, Measure([] { CORE::ApplyOutputScaling(); }));
+#endif
+
+  PrepareFrame(count);
+  Report("Fade", "-", count, Measure([] { CORE::Fade(kTickMs); }));
+
+  for (uint8_t effect = 0; effect < EFFECTS::kEffectCount; ++effect) {
+    PrepareFrame(count);
+    c.effectIndex = effect;
+    Report("Effect", EFFECTS::kEffects[effect].name, count, Measure([] {
+             // NOISE skips windows whose time step did not move; on the lamp it moves every tick
+             auto& noise = EFFECTS::NOISE::GetState();
+             for (bool& valid : noise.valid) valid = false;
+             EFFECTS::Run(kTickMs);
+           }));
+  }
+
+  PrepareFrame(count);
+  uint8_t channel = 0;
+  Report("ShiftScaleChannel", "-", count, Measure([&] {
+           CORE::ShiftScaleChannel(1.0f, channel, (channel & 1) == 0);
+           channel = (channel + 1) & 3;
+         }));
+
+  for (CORE::GradientMode mode : kModes) {
+    PrepareFrame(count);
+    Report("Frame", ModeName(mode), count, Measure([&] {
+             CORE::Fade(kTickMs);
+             CORE::RenderFrame(mode, c.gradientInvertColors);
+           }));
+  }
+}
+
+/**
+ * @brief Render every reference scene and hand the resulting Pixels[] to `sink`.
+ */
+inline void ForEachScene(const std::function<void(const uint8_t* bytes, size_t len)>& sink) {
+  constexpr size_t kSceneCounts[] = { 1, 2, 31, 69, 138, 1000 };
+  constexpr float kLevels[][2] = { { 255.0f, 1.0f }, { 180.0f, 0.85f }, { 3.0f, 0.02f } };
+  constexpr float kShapes[][4] = { { 0.1f, 0.95f, 0.0f, 0.05f }, { 0.33f, 0.2f, 0.15f, 0.3f } };
+
+  auto& v = CORE::GetVars();
+  auto& c = CORE::GetConfig();
+
+  for (size_t count : kSceneCounts) {
+    if (count > CORE::Vars::Capacity) continue;
+    for (CORE::GradientMode mode : kModes) {
+      for (int invert = 0; invert < 2; ++invert) {
+        for (int smooth = 0; smooth < 2; ++smooth) {
+          for (const auto& level : kLevels) {
+            for (const auto& shape : kShapes) {
+              PrepareFrame(count);
+              v.colorOne = { 200.4f, 40.7f, 10.0f, 129.5f };
+              v.brightness = level[0];
+              v.onoffFactor = level[1];
+              c.gradientPaddingBegin = shape[0];
+              c.gradientPaddingValue = shape[1];
+              c.gradientMiddleEdgeSize = shape[2];
+              c.gradientMiddleCenterSize = shape[3];
+              c.gradientInterpolationMode = smooth ? CORE::InterpolationMode::Smooth : CORE::InterpolationMode::Linear;
+
+              CORE::RenderFrame(mode, invert != 0);
+
+              for (size_t i = 0; i < count; ++i) {
+                const uint8_t px[4] = { v.Pixels[i].R, v.Pixels[i].G, v.Pixels[i].B, v.Pixels[i].W };
+                sink(px, sizeof(px));
+              }
+            }
+          }
+        }
+      }
+    }
+  }
+}
+
+inline int DumpScenes(const char* path) {
+  FILE* f = fopen(path, "wb");
+  if (!f) {
+    fprintf(stderr, "cannot open %s\n", path);
+    return 1;
+  }
+  size_t total = 0;
+  ForEachScene([&](const uint8_t* bytes, size_t len) { total += fwrite(bytes, 1, len, f); });
+  fclose(f);
+  printf("wrote %zu bytes of reference frames to %s\n", total, path);
+  return 0;
+}
+
+inline int CompareScenes(const char* path, int tolerance) {
+  FILE* f = fopen(path, "rb");
+  if (!f) {
+    fprintf(stderr, "cannot open %s\n", path);
+    return 1;
+  }
+  size_t total = 0;
+  size_t offByOne = 0;
+  size_t offByMore = 0;
+  int maxDiff = 0;
+  bool truncated = false;
+  ForEachScene([&](const uint8_t* bytes, size_t len) {
+    for (size_t k = 0; k < len; ++k) {
+      const int ref = fgetc(f);
+      if (ref == EOF) {
+        truncated = true;
+        return;
+      }
+      const int diff = abs(static_cast<int>(bytes[k]) - ref);
+      if (diff == 1) ++offByOne;
+      if (diff > 1) ++offByMore;
+      maxDiff = std::max(maxDiff, diff);
+      ++total;
+    }
+  });
+  const bool trailing = (fgetc(f) != EOF);
+  fclose(f);
+
+  if (truncated || trailing) {
+    fprintf(stderr, "reference %s does not match the scene set of this build\n", path);
+    return 1;
+  }
+  printf("compared %zu channels: %zu off by 1, %zu off by more, max difference %d LSB (tolerance %d)\n",
+         total, offByOne, offByMore, maxDiff, tolerance);
+  return maxDiff > tolerance ? 1 : 0;
+}
+
+/**
+ * @brief Fade and effect state after `totalMs` of LED::Update() ticks of `tickMs` each.
+ */
+struct TickState {
+  float brightness;
+  float onoff;
+  CORE::Pixel_float colorOne;
+  CORE::Pixel_float colorTwo;
+  std::vector<float> scale;
+};
+
+inline TickState RunTicks(uint8_t effect, bool active, uint32_t tickMs, uint32_t totalMs) {
+  constexpr size_t kCount = 69;
+  auto& v = CORE::GetVars();
+  auto& c = CORE::GetConfig();
+
+  c.effectIndex = effect;  // PrepareFrame() warms the configured effect up
+  PrepareFrame(kCount);
+  c.colorFadePerSecond = 40.0f;
+  c.brightnessFadePerSecond = 60.0f;
+  c.onoffFadePerSecond = 0.3f;
+  c.effectStepsPerSecond = 37.0f;  // not a multiple of any tick, so fractional steps carry over
+  c.effectActive = true;
+  EFFECTS::Run(totalMs);  // fill the strip with effect output first
+  c.effectActive = active;
+
+  for (uint32_t t = 0; t < totalMs; t += tickMs) {
+    CORE::Fade(tickMs);
+    EFFECTS::Run(tickMs);
+  }
+
+  TickState state{ v.brightness, v.onoffFactor, v.colorOne, v.colorTwo, {} };
+  for (uint8_t channel = 0; channel < 4; ++channel) {
+    const CORE::ScaleSample* window = v.Scale.Window(channel);
+    for (size_t i = 0; i < kCount; ++i) state.scale.push_back(CORE::FromScaleSample(window[i]));
+  }
+  return state;
+}
+
+/**
+ * @brief Compare one second at 1, 4, 10 and 25 ms ticks; fades may differ by float rounding only.
+ */
+inline int TickCheck() {
+  constexpr uint32_t kTicks[] = { 1, 4, 10, 25 };
+  constexpr uint32_t kTotalMs = 1000;
+  constexpr float kFadeTolerance = 0.02f;  // float rounding of up to 1000 steps, far below 1 LSB
+
+  auto near = [&](float a, float b) { return fabsf(a - b) <= kFadeTolerance; };
+  auto nearPixel = [&](const CORE::Pixel_float& a, const CORE::Pixel_float& b) {
+    return near(a.R, b.R) && near(a.G, b.G) && near(a.B, b.B) && near(a.W, b.W);
+  };
+
+  int failures = 0;
+  for (uint8_t effect = 0; effect <= EFFECTS::kEffectCount; ++effect) {
+    // one extra round with the effect switched off: the slide back to 1.0
+    const bool active = effect < EFFECTS::kEffectCount;
+    const uint8_t index = active ? effect : 0;
+    const char* name = active ? EFFECTS::kEffects[effect].name : "(off)";
+
+    const TickState reference = RunTicks(index, active, kTicks[0], kTotalMs);
+    const bool moved = RunTicks(index, active, kTicks[0], 0).scale != reference.scale;
+    if (!moved) {
+      printf("%-10s effect did not move in %lu ms\n", name, static_cast<unsigned long>(kTotalMs));
+      ++failures;
+    }
+    for (size_t k = 1; k < sizeof(kTicks) / sizeof(kTicks[0]); ++k) {
+      const TickState state = RunTicks(index, active, kTicks[k], kTotalMs);
+      const bool fadeSame = near(state.brightness, reference.brightness) && near(state.onoff, reference.onoff) &&
+                            nearPixel(state.colorOne, reference.colorOne) &&
+                            nearPixel(state.colorTwo, reference.colorTwo);
+      const bool effectSame = state.scale == reference.scale;
+      printf("%-10s %2lu ms vs %lu ms ticks: fade %s, effect %s\n", name, static_cast<unsigned long>(kTicks[k]),
+             static_cast<unsigned long>(kTicks[0]), fadeSame ? "same" : "DIFFERS", effectSame ? "same" : "DIFFERS");
+      if (!fadeSame || !effectSame) ++failures;
+    }
+  }
+  return failures ? 1 : 0;
+}
+
+}  // namespace BENCH
+
+int main(int argc, char** argv) {
+#if LED_CORE_WIRE_OUTPUT
+  LED::CORE::GetVars().Pixels.Attach(BENCH::g_wire, LED_COUNT, nullptr);
+#endif
+
+  int tolerance = 1;
+  for (int i = 1; i < argc; ++i) {
+    if (strcmp(argv[i], "--tolerance") == 0 && i + 1 < argc) tolerance = atoi(argv[i + 1]);
+  }
+
+  for (int i = 1; i < argc; ++i) {
+    if (strcmp(argv[i], "--csv") == 0) BENCH::g_csv = true;
+    if (strcmp(argv[i], "--dump") == 0 && i + 1 < argc) return BENCH::DumpScenes(argv[i + 1]);
+    if (strcmp(argv[i], "--compare") == 0 && i + 1 < argc) return BENCH::CompareScenes(argv[i + 1], tolerance);
+    if (strcmp(argv[i], "--tick-check") == 0) return BENCH::TickCheck();
+  }
+
+  BENCH::PrintHeader();
+
+  for (size_t count : BENCH::kCounts) {
+    if (count > LED::CORE::Vars::Capacity) continue;
+    BENCH::RunCount(count);
+  }
+
+  return 0;
+}
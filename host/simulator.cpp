@@ -0,0 +1,428 @@
+//////////////////////////////////
+//  HOST VIRTUAL-CLOCK SIMULATOR  //
+//////////////////////////////////
+/**
+ * @file simulator.cpp
+ * @brief Runs the whole sketch on a virtual clock and replays an input trace.
+ *
+ * The sketch (.ino and every header) is compiled against the shims in this
+ * directory: Arduino.h on a virtual clock, Preferences.h in memory, HomeSpan.h
+ * with injectable characteristic writes. millis()/micros() move only when the
+ * simulator advances them (or the sketch calls delay()), so a run is
+ * reproducible to the frame.
+ *
+ * Trace format, one input per line ('#' starts a comment), times in ms after
+ * setup() returned:
+ *   <ms> HK <light> <characteristic> <value> [<characteristic> <value> ...]
+ *   <ms> CLI <console line>
+ *   <ms> EXPECT IDLE|AWAKE
+ *   <ms> END
+ * HK writes to the <light>-th LightBulb service (1 = Color 1); all pairs on a
+ * line arrive as one update() call, like a single HomeKit write. CLI lines go
+ * to CONSOLE::EvaluateCommand(). EXPECT checks LED::IsIdle() at that time,
+ * before the inputs listed after it; a failed check makes the run exit 1.
+ * Without END the run continues --tail ms after the last input so debounced
+ * settings writes show up.
+ *
+ * For every input the report lists the first output frame after it, when
+ * every fade reached its target (CORE::FadeSettled()) and how many frames
+ * that took, and whether the render loop parked (LED::IsIdle()) before the
+ * next input. With the effect running the loop never parks, but fades still
+ * settle.
+ *
+ * With the WS2801 profile every frame is also checked against the byte
+ * stream the HAL clocked out through the SPI mock (host/SPI.h): the
+ * transaction after a frame must hold exactly that frame in HAL::Format.
+ *
+ * Usage:
+ *   make sim
+ *   make verify        (also replays traces/idle_park.trace, plain and dithered)
+ *   ./build/simulator traces/homekit_color_change.trace [--tick-us 1000] [--tail 20000]
+ *        [--frames frames.csv] [--trace-json trace.json] [--serial]
+ */
+
+#include <Arduino.h>
+
+#include "../LumoLights_DEBUG_BRANCH.ino"
+
+#include <stdio.h>
+
+#include <chrono>
+#include <string>
+#include <vector>
+
+namespace SIM {
+
+struct Input {
+  uint32_t atMs = 0;
+  enum Kind { HOMEKIT, CONSOLE_LINE, EXPECT, END } kind = END;
+  int light = 0;                                     ///< HOMEKIT: 1-based LightBulb index
+  bool expectIdle = false;                           ///< EXPECT: LED::IsIdle() must be this
+  std::vector<std::pair<std::string, double>> writes;  ///< HOMEKIT: characteristic, value
+  std::string text;                                  ///< CONSOLE_LINE: command; also the report label
+
+  // filled while running
+  bool delivered = false;
+  int64_t firstFrameMs = -1;
+  int64_t settledMs = -1;
+  int64_t idleMs = -1;
+  uint32_t frames = 0;  ///< frames until settled
+};
+
+struct Frame {
+  uint32_t timeMs;
+  std::vector<uint8_t> rgbw;
+};
+
+struct Run {
+  std::vector<Input> inputs;
+  std::vector<Frame> frames;
+  uint32_t originMs = 0;  ///< millis() when setup() returned
+  int current = -1;       ///< input whose response is being measured
+  uint32_t frameCount = 0;
+  bool keepFrames = false;
+
+  // SPI check: the wire bytes of the last frame and the SPI transaction that must carry them
+  std::vector<uint8_t> spiExpected;
+  size_t spiTransaction = 0;
+  uint32_t spiChecked = 0;
+  uint32_t spiMismatches = 0;
+
+  uint32_t expectChecked = 0;
+  uint32_t expectFailed = 0;
+};
+
+inline Run& GetRun() {
+  static Run run;
+  return run;
+}
+
+inline uint32_t Now() { return millis() - GetRun().originMs; }
+
+/**
+ * @brief Compare the pending frame with its SPI transaction, once that has been sent.
+ */
+inline void CheckSpi() {
+  Run &run = GetRun();
+  const auto &transactions = HOST::GetSpiBus().transactions;
+  if (run.spiExpected.empty() || run.spiTransaction >= transactions.size()) return;
+  ++run.spiChecked;
+  if (transactions[run.spiTransaction] != run.spiExpected) ++run.spiMismatches;
+  run.spiExpected.clear();
+}
+
+/**
+ * @brief LED::OutputObserver: account the frame to the current input and keep it if asked to.
+ */
+inline void OnFrame(const LED::Vars& v) {
+  Run &run = GetRun();
+  ++run.frameCount;
+
+#if defined(HAL_CONFIG_SINGLE_WS2801)
+  // the observer runs right before the show, so the next transaction carries this frame
+  CheckSpi();
+  run.spiExpected.assign(v.Count * HAL::Format::kStride, 0);
+  for (size_t i = 0; i < v.Count; ++i) {
+    const auto &p = v.Pixels[i];
+    HAL::Format::Encode(run.spiExpected.data() + i * HAL::Format::kStride, p.R, p.G, p.B, p.W);
+  }
+  run.spiTransaction = HOST::GetSpiBus().transactions.size();
+#endif
+
+  if (run.current >= 0) {
+    Input &in = run.inputs[run.current];
+    if (in.firstFrameMs < 0) in.firstFrameMs = Now();
+    if (in.settledMs < 0) ++in.frames;
+  }
+  if (!run.keepFrames) return;
+
+  Frame frame{ Now(), {} };
+  frame.rgbw.reserve(v.Count * 4);
+  for (size_t i = 0; i < v.Count; ++i) {
+    const auto &p = v.Pixels[i];
+    frame.rgbw.insert(frame.rgbw.end(), { p.R, p.G, p.B, p.W });
+  }
+  run.frames.push_back(std::move(frame));
+}
+
+inline bool ParseTrace(const char* path, std::vector<Input>& out) {
+  FILE* f = fopen(path, "r");
+  if (!f) {
+    fprintf(stderr, "cannot open trace %s\n", path);
+    return false;
+  }
+
+  char line[256];
+  int lineNo = 0;
+  bool ok = true;
+  while (fgets(line, sizeof(line), f)) {
+    ++lineNo;
+    char* hash = strchr(line, '#');
+    if (hash) *hash = '\0';
+    line[strcspn(line, "\r\n")] = '\0';
+
+    char kind[8] = {};
+    unsigned long atMs = 0;
+    int consumed = 0;
+    if (sscanf(line, " %lu %7s %n", &atMs, kind, &consumed) < 2) {
+      if (strspn(line, " \t") != strlen(line)) {
+        fprintf(stderr, "%s:%d: expected '<ms> HK|CLI|EXPECT|END ...'\n", path, lineNo);
+        ok = false;
+      }
+      continue;
+    }
+
+    Input in;
+    in.atMs = static_cast<uint32_t>(atMs);
+    const char* rest = line + consumed;
+
+    if (strcasecmp(kind, "END") == 0) {
+      in.kind = Input::END;
+      in.text = "END";
+    } else if (strcasecmp(kind, "CLI") == 0) {
+      in.kind = Input::CONSOLE_LINE;
+      in.text = rest;
+    } else if (strcasecmp(kind, "EXPECT") == 0) {
+      char state[8] = {};
+      int n = 0;
+      if (sscanf(rest, "%7s %n", state, &n) < 1 || rest[n]
+          || (strcasecmp(state, "IDLE") != 0 && strcasecmp(state, "AWAKE") != 0)) {
+        fprintf(stderr, "%s:%d: EXPECT needs IDLE or AWAKE\n", path, lineNo);
+        ok = false;
+        continue;
+      }
+      in.kind = Input::EXPECT;
+      in.expectIdle = strcasecmp(state, "IDLE") == 0;
+      in.text = in.expectIdle ? "EXPECT IDLE" : "EXPECT AWAKE";
+    } else if (strcasecmp(kind, "HK") == 0) {
+      in.kind = Input::HOMEKIT;
+      int n = 0;
+      if (sscanf(rest, "%d %n", &in.light, &n) < 1 || in.light < 1) {
+        fprintf(stderr, "%s:%d: HK needs a light index >= 1\n", path, lineNo);
+        ok = false;
+        continue;
+      }
+      rest += n;
+      in.text = "HK " + std::to_string(in.light);
+      char name[32];
+      double value = 0;
+      while (sscanf(rest, "%31s %lf %n", name, &value, &n) == 2) {
+        in.writes.emplace_back(name, value);
+        in.text += std::string(" ") + name + "=" + std::to_string(static_cast<long>(value));
+        rest += n;
+      }
+      if (in.writes.empty() || *rest) {
+        fprintf(stderr, "%s:%d: HK expects <characteristic> <value> pairs\n", path, lineNo);
+        ok = false;
+        continue;
+      }
+    } else {
+      fprintf(stderr, "%s:%d: unknown input kind '%s'\n", path, lineNo, kind);
+      ok = false;
+      continue;
+    }
+
+    if (!out.empty() && in.atMs < out.back().atMs) {
+      fprintf(stderr, "%s:%d: inputs must be in time order\n", path, lineNo);
+      ok = false;
+    }
+    out.push_back(std::move(in));
+  }
+  fclose(f);
+  return ok;
+}
+
+/**
+ * @brief EXPECT: compare LED::IsIdle() with the trace; false (and a message) on a mismatch.
+ */
+inline bool Check(const Input& in) {
+  Run &run = GetRun();
+  ++run.expectChecked;
+  if (LED::IsIdle() == in.expectIdle) return true;
+  ++run.expectFailed;
+  fprintf(stderr, "t=%lu ms: %s failed, the render loop is %s\n", static_cast<unsigned long>(in.atMs),
+          in.text.c_str(), LED::IsIdle() ? "parked" : "running");
+  return false;
+}
+
+inline bool Deliver(Input& in) {
+  in.delivered = true;
+  if (in.kind == Input::CONSOLE_LINE) {
+    CONSOLE::EvaluateCommand(in.text.c_str());
+    return true;
+  }
+  if (in.kind != Input::HOMEKIT) return true;
+
+  SpanService* light = HOST::FindService("LightBulb", static_cast<size_t>(in.light - 1));
+  if (!light) {
+    fprintf(stderr, "t=%lu ms: no LightBulb service #%d\n", static_cast<unsigned long>(in.atMs), in.light);
+    return false;
+  }
+  for (const auto &w : in.writes) {
+    if (!HOST::QueueWrite(light, w.first.c_str(), w.second)) {
+      fprintf(stderr, "t=%lu ms: light %d has no characteristic %s\n",
+              static_cast<unsigned long>(in.atMs), in.light, w.first.c_str());
+      return false;
+    }
+  }
+  return true;
+}
+
+/**
+ * @brief One pass of the main loop: the sketch's own loop() and nothing else.
+ *
+ * The simulator must not call LED::Update() or friends itself, otherwise it
+ * measures a loop the firmware does not have.
+ */
+inline void LoopOnce() {
+  loop();
+}
+
+inline void WriteFrames(const char* path) {
+  FILE* f = fopen(path, "w");
+  if (!f) {
+    fprintf(stderr, "cannot write %s\n", path);
+    return;
+  }
+  fprintf(f, "time_ms,rgbw_hex\n");
+  for (const Frame &frame : GetRun().frames) {
+    fprintf(f, "%lu,", static_cast<unsigned long>(frame.timeMs));
+    for (uint8_t byte : frame.rgbw) fprintf(f, "%02x", byte);
+    fputc('\n', f);
+  }
+  fclose(f);
+}
+
+inline void Report(uint32_t endMs, double hostMs) {
+  const Run &run = GetRun();
+
+  printf("%3s %8s  %-40s %12s %12s %7s %12s\n", "#", "at ms", "input", "first frame", "settled", "frames", "idle");
+  for (size_t i = 0; i < run.inputs.size(); ++i) {
+    const Input &in = run.inputs[i];
+    if (in.kind == Input::END || in.kind == Input::EXPECT) continue;
+    auto since = [&](char (&buf)[24], int64_t ms) {
+      if (ms >= 0) {
+        snprintf(buf, sizeof(buf), "+%lld ms", static_cast<long long>(ms - in.atMs));
+      } else {
+        snprintf(buf, sizeof(buf), in.delivered ? "never" : "-");
+      }
+    };
+    char first[24], settled[24], idle[24];
+    since(first, in.firstFrameMs);
+    since(settled, in.settledMs);
+    since(idle, in.idleMs);
+    printf("%3zu %8lu  %-40.40s %12s %12s %7lu %12s\n", i + 1, static_cast<unsigned long>(in.atMs), in.text.c_str(),
+           first, settled, static_cast<unsigned long>(in.frames), idle);
+  }
+
+  printf("\nframes: %lu in %lu ms simulated (%.1f fps)\n", static_cast<unsigned long>(run.frameCount),
+         static_cast<unsigned long>(endMs), endMs ? run.frameCount * 1000.0 / endMs : 0.0);
+
+  HAL::IsShowComplete();  // lets the transmitter finish its last frame
+  const HAL::ShowStats &show = HAL::GetShowStats();
+  printf("shows: %lu (async %d), waited %lu times, %.1f ms total, %lu us max, %.1f ms blocking sends, %lu torn\n",
+         static_cast<unsigned long>(show.frames), HAL_ASYNC_SHOW, static_cast<unsigned long>(show.waits),
+         show.waitUs / 1000.0, static_cast<unsigned long>(show.maxWaitUs), show.sendUs / 1000.0,
+         static_cast<unsigned long>(show.torn));
+
+#if defined(HAL_CONFIG_SINGLE_WS2801)
+  CheckSpi();
+  printf("spi: %zu transactions, %llu bytes at %lu Hz; %lu frames checked, %lu mismatches\n",
+         HOST::GetSpiBus().transactions.size(), static_cast<unsigned long long>(HOST::GetSpiBus().bytes),
+         static_cast<unsigned long>(HOST::GetSpiBus().clockHz), static_cast<unsigned long>(run.spiChecked),
+         static_cast<unsigned long>(run.spiMismatches));
+#endif
+
+  if (run.expectChecked) {
+    printf("expect: %lu checks, %lu failed\n", static_cast<unsigned long>(run.expectChecked),
+           static_cast<unsigned long>(run.expectFailed));
+  }
+
+  const auto &writes = HOST::GetNvsWrites();
+  printf("settings writes: %zu\n", writes.size());
+  for (const auto &w : writes) {
+    printf("  %+8ld ms  %s (%zu bytes)\n", static_cast<long>(w.timeMs) - static_cast<long>(run.originMs),
+           w.key.c_str(), w.length);
+  }
+
+  printf("host time: %.1f ms (%.0fx real time)\n", hostMs, hostMs > 0 ? endMs / hostMs : 0.0);
+}
+
+}  // namespace SIM
+
+int main(int argc, char** argv) {
+  const char* tracePath = nullptr;
+  const char* framesPath = nullptr;
+  const char* jsonPath = nullptr;
+  uint32_t tickUs = 1000;
+  uint32_t tailMs = 20000;
+
+  for (int i = 1; i < argc; ++i) {
+    if (strcmp(argv[i], "--tick-us") == 0 && i + 1 < argc) tickUs = static_cast<uint32_t>(atol(argv[++i]));
+    else if (strcmp(argv[i], "--tail") == 0 && i + 1 < argc) tailMs = static_cast<uint32_t>(atol(argv[++i]));
+    else if (strcmp(argv[i], "--frames") == 0 && i + 1 < argc) framesPath = argv[++i];
+    else if (strcmp(argv[i], "--trace-json") == 0 && i + 1 < argc) jsonPath = argv[++i];
+    else if (strcmp(argv[i], "--serial") == 0) HOST::SerialOut() = stderr;
+    else if (argv[i][0] != '-') tracePath = argv[i];
+    else {
+      fprintf(stderr, "unknown option %s\n", argv[i]);
+      return 2;
+    }
+  }
+  if (!tracePath || tickUs == 0) {
+    fprintf(stderr, "usage: %s <trace> [--tick-us N] [--tail MS] [--frames CSV] [--trace-json JSON] [--serial]\n", argv[0]);
+    return 2;
+  }
+
+  SIM::Run &run = SIM::GetRun();
+  if (!SIM::ParseTrace(tracePath, run.inputs)) return 1;
+  run.keepFrames = framesPath != nullptr;
+
+  const auto hostStart = std::chrono::steady_clock::now();
+
+  HOST::UseVirtualClock(true);
+  randomSeed(1);
+  setup();
+  run.originMs = millis();
+  LED::OutputObserver() = SIM::OnFrame;
+  TRACE::Clear();
+
+  uint32_t endMs = run.inputs.empty() ? tailMs : run.inputs.back().atMs + tailMs;
+  if (!run.inputs.empty() && run.inputs.back().kind == SIM::Input::END) endMs = run.inputs.back().atMs;
+
+  size_t next = 0;
+  bool failed = false;
+
+  while (SIM::Now() < endMs && !HOST::RestartRequested()) {
+    while (next < run.inputs.size() && run.inputs[next].atMs <= SIM::Now()) {
+      SIM::Input &in = run.inputs[next];
+      if (in.kind == SIM::Input::END) break;
+      if (in.kind == SIM::Input::EXPECT) {
+        if (!SIM::Check(in)) failed = true;
+        ++next;
+        continue;
+      }
+      if (!SIM::Deliver(in)) failed = true;
+      run.current = static_cast<int>(next);
+      ++next;
+    }
+
+    SIM::LoopOnce();
+    if (run.current >= 0) {
+      SIM::Input &in = run.inputs[run.current];
+      if (in.settledMs < 0 && LED::CORE::FadeSettled()) in.settledMs = SIM::Now();
+      if (in.idleMs < 0 && LED::IsIdle()) in.idleMs = SIM::Now();
+    }
+
+    HOST::AdvanceMicros(tickUs);
+  }
+
+  const double hostMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - hostStart).count();
+
+  SIM::Report(endMs, hostMs);
+  if (HOST::RestartRequested()) printf("stopped: sketch requested ESP.restart() at %lu ms\n", static_cast<unsigned long>(SIM::Now()));
+  if (framesPath) SIM::WriteFrames(framesPath);
+  if (jsonPath && !TRACE::WriteJsonFile(jsonPath)) fprintf(stderr, "cannot write %s\n", jsonPath);
+
+  return failed ? 1 : 0;
+}